@@ -0,0 +1,437 @@
+// Headless physics benchmark. Builds fixed scenes (no RNG) and times
+// PhysicsManager::step() across partition counts, on pyramid stacks, box
+// rain and a mostly sleeping world, plus snapshot save and restore,
+// printing one [physics.bench] line per run and optionally writing a perf
+// report that tools/check_perf_regression.py can compare against a
+// baseline.
+//
+//   physics_benchmark [--bodies 500,2000,10000] [--steps 300] [--warmup 60]
+//                     [--workers N] [--output path.json]
+#include "jobs/JobSystem.hpp"
+#include "miyabi_logic_cxx/lib.h"
+#include "physics/PhysicsManager.hpp"
+#include "profiler/TimingStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using miyabi::jobs::JobSystem;
+using miyabi::physics::PhysicsManager;
+using miyabi::profiler::TimingSamples;
+using miyabi::profiler::TimingSummary;
+
+namespace {
+
+// Containers never touch each other, so each one can live in any partition.
+constexpr size_t CONTAINER_COUNT = 8;
+constexpr size_t CONTAINER_COLUMNS = 10;
+constexpr float BOX_SIZE = 0.5f;
+constexpr float BOX_SPACING = 0.6f;
+constexpr float WALL_THICKNESS = 1.0f;
+constexpr float CONTAINER_GAP = 4.0f;
+constexpr size_t SNAPSHOT_ITERATIONS = 100;
+constexpr size_t PYRAMID_BASE = 20;
+constexpr size_t RAIN_COLUMNS = 100;
+constexpr float RAIN_COLUMN_SPACING = 1.0f;
+constexpr float RAIN_ROW_SPACING = 1.5f;
+constexpr float SHELF_SPACING = 3.0f;
+constexpr size_t SLEEPING_AWAKE_PERCENT = 5;
+constexpr size_t SLEEPING_RAIN_COLUMNS = 4;
+
+struct BenchConfig {
+    std::vector<size_t> body_counts{500, 2000, 10000};
+    size_t steps = 300;
+    size_t warmup = 60;
+    size_t workers = JobSystem::DEFAULT_WORKERS;
+    std::string output_path;
+};
+
+struct ScenarioResult {
+    std::string name;
+    size_t bodies = 0;
+    size_t partitions = 0;
+    size_t workers = 0;
+    TimingSummary timing;
+    double speedup = 1.0;
+};
+
+void create_all(PhysicsManager& physics, const std::vector<BodyDesc>& descs) {
+    std::vector<PhysicsManager::BodyId> ids(descs.size());
+    physics.create_bodies(descs.data(), descs.size(), nullptr, 0, ids.data());
+}
+
+BodyDesc make_box(BodyKind kind, float x, float y, float width, float height, uint32_t partition) {
+    BodyDesc desc{};
+    desc.kind = kind;
+    desc.shape = BodyShapeType::Box;
+    desc.position = {x, y};
+    desc.half_extents = {width / 2.0f, height / 2.0f};
+    desc.density = kind == BodyKind::Dynamic ? 1.0f : 0.0f;
+    desc.friction = kind == BodyKind::Dynamic ? 0.3f : 0.2f;
+    desc.category_bits = 0x0001;
+    desc.mask_bits = 0xFFFF;
+    desc.partition = partition;
+    return desc;
+}
+
+// CONTAINER_COUNT side-by-side boxes with a grid of dynamic boxes dropping
+// into each; container c goes to partition c % partitions.
+void build_container_stacks(PhysicsManager& physics, size_t dynamic_bodies, size_t partitions) {
+    // Half a spacing of slack for the shifted rows.
+    const float inner_width = (static_cast<float>(CONTAINER_COLUMNS) + 0.5f) * BOX_SPACING;
+    const size_t per_container = dynamic_bodies / CONTAINER_COUNT;
+    const size_t remainder = dynamic_bodies % CONTAINER_COUNT;
+    const size_t rows = (per_container + (remainder > 0 ? 1 : 0) + CONTAINER_COLUMNS - 1) / CONTAINER_COLUMNS;
+    const float wall_height = static_cast<float>(rows) * BOX_SPACING + 10.0f;
+
+    std::vector<BodyDesc> descs;
+    descs.reserve(dynamic_bodies + CONTAINER_COUNT * 3);
+    for (size_t c = 0; c < CONTAINER_COUNT; ++c) {
+        const uint32_t partition = static_cast<uint32_t>(c % partitions);
+        const float left = static_cast<float>(c) * (inner_width + 2.0f * WALL_THICKNESS + CONTAINER_GAP);
+        const float center = left + WALL_THICKNESS + inner_width / 2.0f;
+        descs.push_back(make_box(BodyKind::Static, center, -WALL_THICKNESS / 2.0f,
+                                 inner_width + 2.0f * WALL_THICKNESS, WALL_THICKNESS, partition));
+        descs.push_back(make_box(BodyKind::Static, left + WALL_THICKNESS / 2.0f, wall_height / 2.0f,
+                                 WALL_THICKNESS, wall_height, partition));
+        descs.push_back(make_box(BodyKind::Static, left + 1.5f * WALL_THICKNESS + inner_width, wall_height / 2.0f,
+                                 WALL_THICKNESS, wall_height, partition));
+
+        // The first containers take the remainder.
+        const size_t count = per_container + (c < remainder ? 1 : 0);
+        for (size_t i = 0; i < count; ++i) {
+            const size_t row = i / CONTAINER_COLUMNS;
+            const size_t column = i % CONTAINER_COLUMNS;
+            // Odd rows are shifted so the stacks settle instead of standing.
+            const float offset = (row % 2 == 1) ? BOX_SPACING * 0.25f : 0.0f;
+            const float x = left + WALL_THICKNESS + BOX_SPACING * (static_cast<float>(column) + 0.5f) + offset;
+            const float y = 1.0f + BOX_SPACING * static_cast<float>(row);
+            descs.push_back(make_box(BodyKind::Dynamic, x, y, BOX_SIZE, BOX_SIZE, partition));
+        }
+    }
+
+    create_all(physics, descs);
+}
+
+// A static floor whose top is at `top`.
+void add_floor(std::vector<BodyDesc>& descs, float left, float width, float top) {
+    descs.push_back(make_box(BodyKind::Static, left + width / 2.0f, top - WALL_THICKNESS / 2.0f,
+                             width, WALL_THICKNESS, 0));
+}
+
+// Pyramids of PYRAMID_BASE boxes at the base standing side by side; the
+// last one loses its top rows when `dynamic_bodies` runs out.
+void build_pyramids(std::vector<BodyDesc>& descs, size_t dynamic_bodies) {
+    const size_t per_pyramid = PYRAMID_BASE * (PYRAMID_BASE + 1) / 2;
+    const size_t pyramids = std::max<size_t>((dynamic_bodies + per_pyramid - 1) / per_pyramid, 1);
+    const float pyramid_width = static_cast<float>(PYRAMID_BASE) * BOX_SPACING + CONTAINER_GAP;
+    add_floor(descs, 0.0f, static_cast<float>(pyramids) * pyramid_width, 0.0f);
+
+    size_t placed = 0;
+    for (size_t p = 0; p < pyramids; ++p) {
+        const float left = static_cast<float>(p) * pyramid_width + CONTAINER_GAP / 2.0f;
+        for (size_t row = 0; row < PYRAMID_BASE && placed < dynamic_bodies; ++row) {
+            for (size_t column = 0; column < PYRAMID_BASE - row && placed < dynamic_bodies; ++column, ++placed) {
+                // Each box straddles the two below it.
+                const float x = left + BOX_SPACING * (static_cast<float>(column) + 0.5f + 0.5f * static_cast<float>(row));
+                const float y = BOX_SIZE * (static_cast<float>(row) + 0.5f);
+                descs.push_back(make_box(BodyKind::Dynamic, x, y, BOX_SIZE, BOX_SIZE, 0));
+            }
+        }
+    }
+}
+
+// `columns` (at most RAIN_COLUMNS) columns of boxes released from staggered
+// heights over the middle of a floor starting at `left`; fewer columns
+// keep bodies landing for longer.
+void add_rain(std::vector<BodyDesc>& descs, size_t dynamic_bodies, float left, size_t columns) {
+    add_floor(descs, left, static_cast<float>(RAIN_COLUMNS) * RAIN_COLUMN_SPACING, 0.0f);
+    const float first = left + RAIN_COLUMN_SPACING * static_cast<float>(RAIN_COLUMNS - columns) / 2.0f;
+    for (size_t i = 0; i < dynamic_bodies; ++i) {
+        const size_t row = i / columns;
+        const size_t column = i % columns;
+        const float offset = (row % 2 == 1) ? RAIN_COLUMN_SPACING * 0.25f : 0.0f;
+        const float x = first + RAIN_COLUMN_SPACING * (static_cast<float>(column) + 0.5f) + offset;
+        const float y = 2.0f + RAIN_ROW_SPACING * static_cast<float>(row);
+        descs.push_back(make_box(BodyKind::Dynamic, x, y, BOX_SIZE, BOX_SIZE, 0));
+    }
+}
+
+void build_rain(std::vector<BodyDesc>& descs, size_t dynamic_bodies) {
+    add_rain(descs, dynamic_bodies, 0.0f, RAIN_COLUMNS);
+}
+
+// Boxes resting apart on stacked shelves, asleep before warmup ends, next
+// to a narrow rain of a few percent of the bodies that is still landing
+// while steps are timed.
+void build_sleeping(std::vector<BodyDesc>& descs, size_t dynamic_bodies) {
+    const size_t awake = dynamic_bodies * SLEEPING_AWAKE_PERCENT / 100;
+    const size_t resting = dynamic_bodies - awake;
+    const float shelf_width = static_cast<float>(RAIN_COLUMNS) * RAIN_COLUMN_SPACING;
+    const size_t shelves = (resting + RAIN_COLUMNS - 1) / RAIN_COLUMNS;
+    for (size_t shelf = 0; shelf < shelves; ++shelf) {
+        add_floor(descs, 0.0f, shelf_width, SHELF_SPACING * static_cast<float>(shelf));
+    }
+    for (size_t i = 0; i < resting; ++i) {
+        const float x = RAIN_COLUMN_SPACING * (static_cast<float>(i % RAIN_COLUMNS) + 0.5f);
+        const float y = SHELF_SPACING * static_cast<float>(i / RAIN_COLUMNS) + BOX_SIZE / 2.0f;
+        descs.push_back(make_box(BodyKind::Dynamic, x, y, BOX_SIZE, BOX_SIZE, 0));
+    }
+    add_rain(descs, awake, shelf_width + CONTAINER_GAP, SLEEPING_RAIN_COLUMNS);
+}
+
+void print_result(const ScenarioResult& result) {
+    std::cout << "[physics.bench] scenario=" << result.name
+              << " bodies=" << result.bodies
+              << " partitions=" << result.partitions
+              << " workers=" << result.workers
+              << " avg_ms=" << result.timing.avg_ms
+              << " p50_ms=" << result.timing.p50_ms
+              << " p95_ms=" << result.timing.p95_ms
+              << " p99_ms=" << result.timing.p99_ms
+              << " speedup=" << result.speedup << std::endl;
+}
+
+TimingSummary run_steps(PhysicsManager& physics, const BenchConfig& config) {
+    for (size_t i = 0; i < config.warmup; ++i) {
+        physics.step();
+    }
+    TimingSamples samples(config.steps);
+    for (size_t i = 0; i < config.steps; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        physics.step();
+        const auto end = std::chrono::steady_clock::now();
+        samples.add(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return samples.summarize();
+}
+
+std::vector<size_t> partition_counts(size_t participants) {
+    std::vector<size_t> counts{1, 2, 4, std::min(participants, CONTAINER_COUNT)};
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+    return counts;
+}
+
+void run_container_stacks(const BenchConfig& config, JobSystem& jobs, std::vector<ScenarioResult>& results) {
+    for (size_t bodies : config.body_counts) {
+        double serial_avg_ms = 0.0;
+        for (size_t partitions : partition_counts(jobs.participant_count())) {
+            PhysicsManager physics;
+            physics.init(partitions);
+            physics.set_job_system(&jobs);
+            build_container_stacks(physics, bodies, partitions);
+
+            ScenarioResult result;
+            result.name = "physics_step_" + std::to_string(bodies) + "_p" + std::to_string(partitions);
+            result.bodies = bodies;
+            result.partitions = partitions;
+            result.workers = partitions > 1 ? jobs.worker_count() : 0;
+            result.timing = run_steps(physics, config);
+            if (partitions == 1) {
+                serial_avg_ms = result.timing.avg_ms;
+            }
+            result.speedup = result.timing.avg_ms > 0.0 ? serial_avg_ms / result.timing.avg_ms : 0.0;
+            physics.set_job_system(nullptr);
+            print_result(result);
+            results.push_back(result);
+        }
+    }
+}
+
+// Single-partition step times of scenes with different contact and sleep
+// profiles.
+void run_scenes(const BenchConfig& config, std::vector<ScenarioResult>& results) {
+    const std::pair<const char*, void (*)(std::vector<BodyDesc>&, size_t)> scenes[] = {
+        { "physics_pyramid_", build_pyramids },
+        { "physics_rain_", build_rain },
+        { "physics_sleeping_", build_sleeping },
+    };
+    for (const auto& scene : scenes) {
+        for (size_t bodies : config.body_counts) {
+            std::vector<BodyDesc> descs;
+            descs.reserve(bodies + bodies / RAIN_COLUMNS + 2);
+            scene.second(descs, bodies);
+
+            PhysicsManager physics;
+            physics.init(1);
+            create_all(physics, descs);
+
+            ScenarioResult result;
+            result.name = scene.first + std::to_string(bodies);
+            result.bodies = bodies;
+            result.partitions = 1;
+            result.timing = run_steps(physics, config);
+            print_result(result);
+            results.push_back(result);
+        }
+    }
+}
+
+// Saves and restores a settled container scene; the snapshot must stay
+// cheap enough to take every frame.
+void run_snapshots(const BenchConfig& config, std::vector<ScenarioResult>& results) {
+    for (size_t bodies : config.body_counts) {
+        PhysicsManager physics;
+        physics.init(1);
+        build_container_stacks(physics, bodies, 1);
+        for (size_t i = 0; i < config.warmup; ++i) {
+            physics.step();
+        }
+
+        std::vector<uint8_t> snapshot;
+        TimingSamples save_samples(SNAPSHOT_ITERATIONS);
+        for (size_t i = 0; i < SNAPSHOT_ITERATIONS; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            physics.save_snapshot(snapshot);
+            const auto end = std::chrono::steady_clock::now();
+            save_samples.add(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        TimingSamples restore_samples(SNAPSHOT_ITERATIONS);
+        for (size_t i = 0; i < SNAPSHOT_ITERATIONS; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            const bool restored = physics.restore_snapshot(snapshot.data(), snapshot.size());
+            const auto end = std::chrono::steady_clock::now();
+            if (!restored) {
+                std::cerr << "physics_benchmark - snapshot restore failed bodies=" << bodies << std::endl;
+                break;
+            }
+            restore_samples.add(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::cout << "[physics.bench] snapshot_bytes=" << snapshot.size() << " bodies=" << bodies << std::endl;
+
+        const std::pair<const char*, const TimingSamples*> runs[] = {
+            { "physics_snapshot_save_", &save_samples },
+            { "physics_snapshot_restore_", &restore_samples },
+        };
+        for (const auto& run : runs) {
+            ScenarioResult result;
+            result.name = run.first + std::to_string(bodies);
+            result.bodies = bodies;
+            result.partitions = 1;
+            result.timing = run.second->summarize();
+            print_result(result);
+            results.push_back(result);
+        }
+    }
+}
+
+bool write_report(const std::string& path, const std::vector<ScenarioResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "physics_benchmark - cannot open " << path << std::endl;
+        return false;
+    }
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n"
+        << "  \"schema_version\": 1,\n"
+        << "  \"source\": \"core/benchmarks/physics_benchmark.cpp\",\n"
+        << "  \"scenarios\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ScenarioResult& result = results[i];
+        out << "    {\n"
+            << "      \"name\": \"" << result.name << "\",\n"
+            << "      \"bodies\": " << result.bodies << ",\n"
+            << "      \"partitions\": " << result.partitions << ",\n"
+            << "      \"workers\": " << result.workers << ",\n"
+            << "      \"speedup\": " << result.speedup << ",\n"
+            << "      \"avg_ms\": " << result.timing.avg_ms << ",\n"
+            << "      \"p50_ms\": " << result.timing.p50_ms << ",\n"
+            << "      \"p95_ms\": " << result.timing.p95_ms << ",\n"
+            << "      \"p99_ms\": " << result.timing.p99_ms << ",\n"
+            << "      \"min_ms\": " << result.timing.min_ms << ",\n"
+            << "      \"max_ms\": " << result.timing.max_ms << ",\n"
+            << "      \"iterations\": " << result.timing.iterations << "\n"
+            << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool parse_size(const char* flag, const char* value, size_t& out) {
+    if (!value) {
+        std::cerr << "physics_benchmark - " << flag << " requires a value" << std::endl;
+        return false;
+    }
+    char* end = nullptr;
+    const unsigned long long parsed = std::strtoull(value, &end, 10);
+    if (end == value || *end != '\0') {
+        std::cerr << "physics_benchmark - invalid " << flag << " value: " << value << std::endl;
+        return false;
+    }
+    out = static_cast<size_t>(parsed);
+    return true;
+}
+
+bool parse_args(int argc, char** argv, BenchConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg == "--output") {
+            if (!value) {
+                std::cerr << "physics_benchmark - --output requires a path" << std::endl;
+                return false;
+            }
+            config.output_path = value;
+            ++i;
+        } else if (arg == "--steps") {
+            if (!parse_size("--steps", value, config.steps) || config.steps == 0) return false;
+            ++i;
+        } else if (arg == "--warmup") {
+            if (!parse_size("--warmup", value, config.warmup)) return false;
+            ++i;
+        } else if (arg == "--workers") {
+            if (!parse_size("--workers", value, config.workers)) return false;
+            ++i;
+        } else if (arg == "--bodies") {
+            if (!value) {
+                std::cerr << "physics_benchmark - --bodies requires a list" << std::endl;
+                return false;
+            }
+            config.body_counts.clear();
+            std::stringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                size_t count = 0;
+                if (!parse_size("--bodies", item.c_str(), count)) return false;
+                config.body_counts.push_back(count);
+            }
+            ++i;
+        } else {
+            std::cerr << "physics_benchmark - unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if (!parse_args(argc, argv, config)) {
+        return 2;
+    }
+
+    JobSystem jobs(config.workers);
+    std::vector<ScenarioResult> results;
+    run_container_stacks(config, jobs, results);
+    run_scenes(config, results);
+    run_snapshots(config, results);
+
+    if (!config.output_path.empty()) {
+        if (!write_report(config.output_path, results)) {
+            return 1;
+        }
+        std::cout << "[physics.bench] report=" << config.output_path << std::endl;
+    }
+    return 0;
+}
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include "rust/cxx.h"
 
 // Forward-declare types defined in Rust.
 struct Vec2;
 struct CollisionEvent;
+struct BodyState;
+struct BodyDesc;
+struct RayCastQuery;
+struct ShapeCastQuery;
+struct AabbQuery;
+struct QueryHit;
+struct QueryRange;
+struct PhysicsStepConfig;
 
 // FFI functions for Rust to call
 void play_sound(rust::Str path);
@@ -16,8 +25,35 @@ void request_fullscreen(bool enabled);
 void request_window_close();
 uint64_t create_dynamic_box_body(float x, float y, float width, float height);
 uint64_t create_static_box_body(float x, float y, float width, float height);
+bool destroy_body(uint64_t id);
+// Batch variants: one id per descriptor (0 for invalid ones); polygon
+// descriptors index into `vertices`. Both return the number of bodies
+// created or destroyed.
+size_t create_bodies(rust::Slice<const BodyDesc> descs, rust::Slice<const Vec2> vertices, rust::Slice<uint64_t> out_ids);
+size_t destroy_bodies(rust::Slice<const uint64_t> ids);
 Vec2 get_body_position(uint64_t id);
+// Contact events of the last step. The slice borrows the published half of
+// a double-buffered arena and stays valid until the end of the next step.
 rust::Slice<const CollisionEvent> get_collision_events();
+// Bulk state export, refreshed after every physics step. Prefer these over
+// per-body get_body_position() calls.
+rust::Slice<const BodyState> get_body_states();
+size_t fill_body_states(rust::Slice<const uint64_t> ids, rust::Slice<BodyState> out);
+rust::Slice<const BodyState> get_moved_body_states();
+// Batched broadphase queries into caller-owned buffers (one hit per ray or
+// shape cast; packed ids plus one range per AABB query).
+size_t raycast_bodies(rust::Slice<const RayCastQuery> queries, rust::Slice<QueryHit> out_hits);
+size_t shape_cast_bodies(rust::Slice<const ShapeCastQuery> queries, rust::Slice<QueryHit> out_hits);
+size_t query_aabb_bodies(rust::Slice<const AabbQuery> queries, rust::Slice<uint64_t> out_ids, rust::Slice<QueryRange> out_ranges);
+// Binary snapshot of the whole physics world. The slice borrows a buffer
+// that the next save_physics_snapshot() call overwrites.
+rust::Slice<const uint8_t> save_physics_snapshot();
+bool restore_physics_snapshot(rust::Slice<const uint8_t> data);
+// Step rate, iterations, sub-steps, continuous collision and the adaptive
+// per-step budget. Invalid configs are rejected (false) and logged.
+bool set_physics_step_config(const PhysicsStepConfig& config);
+PhysicsStepConfig get_physics_step_config();
+bool set_body_bullet(uint64_t id, bool bullet);
 
 #if defined(MIYABI_PERFORMANCE_TEST)
 uint32_t get_performance_test_sprite_count();
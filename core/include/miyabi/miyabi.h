@@ -8,7 +8,7 @@
 #define MIYABI_SDK_VERSION_PATCH 0
 
 #define MIYABI_ABI_VERSION_MAJOR 1
-#define MIYABI_ABI_VERSION_MINOR 0
+#define MIYABI_ABI_VERSION_MINOR 1
 #define MIYABI_ABI_VERSION_PATCH 0
 #define MIYABI_ABI_VERSION_ENCODE(major, minor, patch) \
     (((uint32_t)(major) << 16) | ((uint32_t)(minor) << 8) | (uint32_t)(patch))
@@ -51,6 +51,13 @@ struct TextCommandSlice {
     const TextCommand* end() const { return ptr + len; }
 };
 
+// Defines a non-owning view of UTF-8 bytes owned by Rust. Not NUL-terminated.
+// Valid for as long as the slice the owning command came from.
+struct MiyabiStringView {
+    const char* ptr;
+    size_t len;
+};
+
 // The complete API provided by the Rust dynamic library, exposed as a C-style VTable.
 struct MiyabiVTable {
     uint32_t abi_version;
@@ -69,4 +76,8 @@ struct MiyabiVTable {
     TextCommandSlice (*get_text_commands)(Game* game);
     const char* (*get_text_command_text_cstring)(const TextCommand* command);
     void (*free_cstring)(char* s);
+    // ABI 1.1: allocation-free alternatives to the *_cstring entries above,
+    // which are kept for existing hosts.
+    MiyabiStringView (*get_asset_command_path_view)(const AssetCommand* command);
+    MiyabiStringView (*get_text_command_text_view)(const TextCommand* command);
 };
@@ -0,0 +1,223 @@
+#include "assets/AssetWatcher.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+namespace fs = std::filesystem;
+
+// How long the watcher thread blocks before re-checking for stop().
+constexpr int WAIT_TIMEOUT_MS = 100;
+constexpr std::chrono::milliseconds POLLING_SCAN_INTERVAL(250);
+
+std::string normalize_path(const fs::path& path) {
+    return path.lexically_normal().generic_string();
+}
+} // namespace
+
+ChangeDebouncer::ChangeDebouncer(std::chrono::milliseconds window) : m_window(window) {}
+
+void ChangeDebouncer::record(const std::string& path, Clock::time_point when) {
+    m_last_change[path] = when;
+}
+
+std::vector<std::string> ChangeDebouncer::take_ready(Clock::time_point now) {
+    std::vector<std::string> ready;
+    for (auto it = m_last_change.begin(); it != m_last_change.end();) {
+        if (now - it->second >= m_window) {
+            ready.push_back(it->first);
+            it = m_last_change.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::sort(ready.begin(), ready.end());
+    return ready;
+}
+
+AssetWatcher::AssetWatcher(std::vector<std::string> roots, std::chrono::milliseconds debounce)
+    :
+#if defined(__linux__)
+      m_inotify_fd(-1),
+#endif
+      m_roots(std::move(roots)),
+      m_debouncer(debounce),
+      m_running(false) {}
+
+AssetWatcher::~AssetWatcher() {
+    stop();
+}
+
+const char* AssetWatcher::backend() const {
+#if defined(__linux__)
+    return "inotify";
+#else
+    return "polling";
+#endif
+}
+
+bool AssetWatcher::start() {
+    if (m_running) {
+        return true;
+    }
+
+#if defined(__linux__)
+    m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify_fd < 0) {
+        std::cerr << "AssetWatcher::start - inotify_init1 failed" << std::endl;
+        return false;
+    }
+    bool watching = false;
+    for (const std::string& root : m_roots) {
+        watching = add_inotify_watches(root) || watching;
+    }
+    if (!watching) {
+        close(m_inotify_fd);
+        m_inotify_fd = -1;
+        std::cerr << "AssetWatcher::start - no watchable directory" << std::endl;
+        return false;
+    }
+    m_running = true;
+    m_thread = std::thread(&AssetWatcher::run_inotify, this);
+#else
+    m_running = true;
+    m_thread = std::thread(&AssetWatcher::run_polling, this);
+#endif
+
+    std::cout << "[asset.hot_reload] watching backend=" << backend() << " roots=";
+    for (size_t i = 0; i < m_roots.size(); ++i) {
+        std::cout << (i > 0 ? "," : "") << m_roots[i];
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+void AssetWatcher::stop() {
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+#if defined(__linux__)
+    if (m_inotify_fd >= 0) {
+        close(m_inotify_fd);
+        m_inotify_fd = -1;
+    }
+    m_watch_directories.clear();
+#endif
+}
+
+std::vector<std::string> AssetWatcher::poll_changes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_debouncer.pending_count() == 0) {
+        return {};
+    }
+    return m_debouncer.take_ready(ChangeDebouncer::Clock::now());
+}
+
+void AssetWatcher::record_change(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_debouncer.record(path, ChangeDebouncer::Clock::now());
+}
+
+void AssetWatcher::run_polling() {
+    // Baseline scan so only changes after start() are reported.
+    std::unordered_map<std::string, fs::file_time_type> known;
+    bool baseline = true;
+    while (m_running) {
+        for (const std::string& root : m_roots) {
+            std::error_code ec;
+            for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+                if (!it->is_regular_file(ec)) {
+                    continue;
+                }
+                const std::string path = normalize_path(it->path());
+                const fs::file_time_type mtime = it->last_write_time(ec);
+                auto found = known.find(path);
+                if (found == known.end() || found->second != mtime) {
+                    known[path] = mtime;
+                    if (!baseline) {
+                        record_change(path);
+                    }
+                }
+            }
+        }
+        baseline = false;
+
+        const auto wake = std::chrono::steady_clock::now() + POLLING_SCAN_INTERVAL;
+        while (m_running && std::chrono::steady_clock::now() < wake) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS));
+        }
+    }
+}
+
+#if defined(__linux__)
+bool AssetWatcher::add_inotify_watches(const std::string& directory) {
+    std::error_code ec;
+    if (!fs::is_directory(directory, ec)) {
+        return false;
+    }
+
+    // inotify is not recursive: every subdirectory needs its own watch.
+    std::vector<std::string> directories = { normalize_path(directory) };
+    for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_directory(ec)) {
+            directories.push_back(normalize_path(it->path()));
+        }
+    }
+
+    constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+    bool added = false;
+    for (const std::string& path : directories) {
+        const int wd = inotify_add_watch(m_inotify_fd, path.c_str(), WATCH_MASK);
+        if (wd < 0) {
+            std::cerr << "AssetWatcher - inotify_add_watch failed path=\"" << path << "\"" << std::endl;
+            continue;
+        }
+        m_watch_directories[wd] = path;
+        added = true;
+    }
+    return added;
+}
+
+void AssetWatcher::run_inotify() {
+    alignas(struct inotify_event) char buffer[4096];
+    while (m_running) {
+        pollfd descriptor = { m_inotify_fd, POLLIN, 0 };
+        const int ready = ::poll(&descriptor, 1, WAIT_TIMEOUT_MS);
+        if (ready <= 0 || (descriptor.revents & POLLIN) == 0) {
+            continue;
+        }
+
+        const ssize_t length = read(m_inotify_fd, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+
+            auto directory = m_watch_directories.find(event->wd);
+            if (directory == m_watch_directories.end() || event->len == 0) {
+                continue;
+            }
+            const std::string path = normalize_path(fs::path(directory->second) / event->name);
+            if ((event->mask & IN_ISDIR) != 0) {
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+                    add_inotify_watches(path);
+                }
+                continue;
+            }
+            // IN_CREATE alone fires before the content is written; wait for
+            // IN_CLOSE_WRITE (in-place save) or IN_MOVED_TO (atomic save).
+            if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                record_change(path);
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Coalesces bursts of change notifications per path. Editors typically save
+// with several writes or a write+rename, so a path is only reported once it
+// has been quiet for the debounce window.
+class ChangeDebouncer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ChangeDebouncer(std::chrono::milliseconds window);
+
+    void record(const std::string& path, Clock::time_point when);
+
+    // Removes and returns (sorted) every path quiet since `now - window`.
+    std::vector<std::string> take_ready(Clock::time_point now);
+
+    size_t pending_count() const { return m_last_change.size(); }
+
+private:
+    std::chrono::milliseconds m_window;
+    std::unordered_map<std::string, Clock::time_point> m_last_change;
+};
+
+// Watches directory trees on a background thread and hands debounced file
+// changes to the main thread. Uses inotify on Linux and falls back to
+// periodic mtime scans elsewhere. Reported paths are relative to the working
+// directory in generic form (e.g. "assets/player.png"), matching the keys
+// the resource managers were loaded with.
+class AssetWatcher {
+public:
+    AssetWatcher(std::vector<std::string> roots, std::chrono::milliseconds debounce);
+    ~AssetWatcher();
+
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+    // Starts the watcher thread. Returns false if no root could be watched.
+    bool start();
+    void stop();
+
+    // Main thread: changed files whose debounce window has elapsed.
+    std::vector<std::string> poll_changes();
+
+    // "inotify" or "polling".
+    const char* backend() const;
+
+private:
+    void record_change(const std::string& path);
+    void run_polling();
+#if defined(__linux__)
+    bool add_inotify_watches(const std::string& directory);
+    void run_inotify();
+
+    int m_inotify_fd;
+    std::unordered_map<int, std::string> m_watch_directories;
+#endif
+
+    std::vector<std::string> m_roots;
+    std::mutex m_mutex;
+    ChangeDebouncer m_debouncer;
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+};
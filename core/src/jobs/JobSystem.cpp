@@ -0,0 +1,110 @@
+#include "jobs/JobSystem.hpp"
+
+#include "profiler/Profiler.hpp"
+
+#include <string>
+
+namespace miyabi {
+namespace jobs {
+
+JobSystem::JobSystem(size_t worker_count)
+    : m_generation(0),
+      m_active_workers(0),
+      m_stopping(false),
+      m_fn(nullptr),
+      m_count(0),
+      m_static_schedule(false),
+      m_next_index(0) {
+    if (worker_count == DEFAULT_WORKERS) {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        worker_count = hardware > 1 ? hardware - 1 : 0;
+    }
+    m_workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        m_workers.emplace_back(&JobSystem::worker_main, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_work_ready.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::parallel_for(size_t count, const std::function<void(size_t, size_t)>& fn, bool static_schedule) {
+    if (count == 0) {
+        return;
+    }
+    if (m_workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fn = &fn;
+        m_count = count;
+        m_static_schedule = static_schedule;
+        m_next_index.store(0, std::memory_order_relaxed);
+        m_active_workers = m_workers.size();
+        ++m_generation;
+    }
+    m_work_ready.notify_all();
+
+    run_indices(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_work_done.wait(lock, [this] { return m_active_workers == 0; });
+    m_fn = nullptr;
+}
+
+void JobSystem::worker_main(size_t participant) {
+    profiler::set_thread_name("job-worker-" + std::to_string(participant));
+    uint64_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_work_ready.wait(lock, [&] { return m_stopping || m_generation != seen_generation; });
+            if (m_stopping) {
+                return;
+            }
+            seen_generation = m_generation;
+        }
+
+        run_indices(participant);
+
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            last = --m_active_workers == 0;
+        }
+        if (last) {
+            m_work_done.notify_one();
+        }
+    }
+}
+
+void JobSystem::run_indices(size_t participant) {
+    const std::function<void(size_t, size_t)>& fn = *m_fn;
+    if (m_static_schedule) {
+        const size_t stride = participant_count();
+        for (size_t i = participant; i < m_count; i += stride) {
+            fn(i, participant);
+        }
+        return;
+    }
+    for (size_t i = m_next_index.fetch_add(1, std::memory_order_relaxed); i < m_count;
+         i = m_next_index.fetch_add(1, std::memory_order_relaxed)) {
+        fn(i, participant);
+    }
+}
+
+} // namespace jobs
+} // namespace miyabi
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miyabi {
+namespace jobs {
+
+// Fixed pool of worker threads for fork/join work inside a frame (physics
+// partitions today). parallel_for() blocks until every index has run; the
+// calling thread takes part, so a pool with 0 workers runs everything
+// inline. Only one parallel_for may run at a time.
+class JobSystem {
+public:
+    // Passing DEFAULT_WORKERS uses hardware_concurrency() - 1.
+    static constexpr size_t DEFAULT_WORKERS = static_cast<size_t>(-1);
+
+    explicit JobSystem(size_t worker_count = DEFAULT_WORKERS);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    size_t worker_count() const { return m_workers.size(); }
+    // Workers plus the calling thread.
+    size_t participant_count() const { return m_workers.size() + 1; }
+
+    // Runs fn(index, participant) for every index in [0, count). Participant
+    // 0 is the calling thread, 1..worker_count() the workers.
+    //
+    // Dynamic scheduling hands indices out first come, first served. Static
+    // scheduling runs index i on participant i % participant_count(), so
+    // the same work lands on the same thread every call.
+    void parallel_for(size_t count, const std::function<void(size_t, size_t)>& fn, bool static_schedule = false);
+
+private:
+    void worker_main(size_t participant);
+    void run_indices(size_t participant);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_work_done;
+    uint64_t m_generation;
+    size_t m_active_workers;
+    bool m_stopping;
+
+    // Current job; written under m_mutex before the generation bump.
+    const std::function<void(size_t, size_t)>* m_fn;
+    size_t m_count;
+    bool m_static_schedule;
+    std::atomic<size_t> m_next_index;
+};
+
+} // namespace jobs
+} // namespace miyabi
@@ -2,11 +2,12 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <thread>
 #include <atomic>
 #include <cstdio>
-#include <unordered_map>
+#include <cstdlib>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -24,6 +25,12 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include "profiler/Profiler.hpp"
+#include "profiler/GpuProfiler.hpp"
+#include "profiler/FrameStats.hpp"
+#ifdef MIYABI_ASSET_HOT_RELOAD
+#include "assets/AssetWatcher.hpp"
+#include <filesystem>
+#endif
 
 // Enum to mirror Rust's GameState
 enum GameState {
@@ -40,12 +47,14 @@ const uint32_t QUAD_MESH_ID = 1;
 const uint32_t ARENA_CUBE_MESH_ID = 100;
 const uint32_t MATERIAL_ID_TEXTURED_2D = 1;
 const uint32_t MATERIAL_ID_LIT_TEXTURED_3D = 2;
+const char* const STANDARD_VERTEX_SHADER_PATH = "core/src/shaders/standard.vert";
+const char* const STANDARD_FRAGMENT_SHADER_PATH = "core/src/shaders/standard.frag";
+const float DEFAULT_ALPHA_CUTOFF = 0.5f;
 
+// Per-scene light; per-surface strengths live in each material's MaterialParams.
 struct DirectionalLight {
     glm::vec3 direction;
     glm::vec3 color;
-    float ambient_strength;
-    float diffuse_strength;
 };
 
 namespace {
@@ -68,27 +77,63 @@ void configure_instanced_model_attributes(uint32_t vao, uint32_t instance_vbo) {
     glBindVertexArray(0);
 }
 
-void set_vec3_uniform_if_present(
-    uint32_t program_id,
-    const char* name,
-    const glm::vec3& value
-) {
-    const int location = glGetUniformLocation(program_id, name);
-    if (location != -1) {
-        glUniform3fv(location, 1, glm::value_ptr(value));
+// Applies only the bits that differ from the previously applied state.
+void apply_material_render_state(uint32_t render_state, uint32_t& applied_render_state) {
+    const uint32_t changed = render_state ^ applied_render_state;
+    if (changed & MATERIAL_STATE_DEPTH_TEST) {
+        if (render_state & MATERIAL_STATE_DEPTH_TEST) {
+            glEnable(GL_DEPTH_TEST);
+        } else {
+            glDisable(GL_DEPTH_TEST);
+        }
     }
+    if (changed & MATERIAL_STATE_ALPHA_BLEND) {
+        if (render_state & MATERIAL_STATE_ALPHA_BLEND) {
+            glEnable(GL_BLEND);
+        } else {
+            glDisable(GL_BLEND);
+        }
+    }
+    applied_render_state = render_state;
 }
 
-void set_float_uniform_if_present(
-    uint32_t program_id,
-    const char* name,
-    float value
-) {
-    const int location = glGetUniformLocation(program_id, name);
-    if (location != -1) {
-        glUniform1f(location, value);
+#ifdef MIYABI_PROFILE
+// Frames recorded by an F9 trace capture.
+constexpr uint32_t TRACE_CAPTURE_DEFAULT_FRAMES = 120;
+
+// Starts a Chrome trace capture written to "<base>_<n>.json", where the
+// base comes from MIYABI_TRACE_OUTPUT (default "miyabi_trace").
+void start_trace_capture(uint32_t frames, int& capture_count) {
+    const char* output_env = std::getenv("MIYABI_TRACE_OUTPUT");
+    const std::string base = output_env && output_env[0] != '\0' ? output_env : "miyabi_trace";
+    const std::string path = base + "_" + std::to_string(capture_count) + ".json";
+    if (miyabi::profiler::Profiler::instance().start_capture(frames, path)) {
+        ++capture_count;
+    }
+}
+
+// Frames slower than this are logged with their scope breakdown. 1.5x a
+// 60 Hz frame, so ordinary vsync jitter is not reported.
+constexpr double DEFAULT_FRAME_BUDGET_MS = 25.0;
+
+// Logs the scopes the main thread completed during the last frame, which
+// Profiler::collect() has just drained.
+void log_frame_hitch(const miyabi::profiler::FrameStats& frame_stats, double frame_ms) {
+    std::cout << "[frame.hitch] frame=" << frame_stats.frame_index()
+              << " frame_ms=" << frame_ms
+              << " budget_ms=" << frame_stats.budget_ms()
+              << std::endl;
+    for (const auto& scope : miyabi::profiler::Profiler::instance().report()) {
+        if (scope.thread != "main" || scope.last_collect_calls == 0) {
+            continue;
+        }
+        std::cout << "[frame.hitch] scope=" << scope.path
+                  << " ms=" << scope.last_collect_ms
+                  << " calls=" << scope.last_collect_calls
+                  << std::endl;
     }
 }
+#endif
 } // namespace
 
 // --- Function Prototypes ---
@@ -114,9 +159,8 @@ static void process_asset_commands(
 ) {
     AssetCommandSlice asset_commands = g_vtable.get_asset_commands(miyabi_game);
     for (const auto& command : asset_commands) {
-        const char* c_path = g_vtable.get_asset_command_path_cstring(&command);
-        std::string path(c_path);
-        g_vtable.free_cstring((char*)c_path);
+        const MiyabiStringView path_view = g_vtable.get_asset_command_path_view(&command);
+        const std::string path(path_view.ptr, path_view.len);
 
         uint32_t loaded_texture_id = 0;
         switch (command.type_) {
@@ -144,6 +188,38 @@ static void process_asset_commands(
     }
 }
 
+#ifdef MIYABI_ASSET_HOT_RELOAD
+// Routes each changed file to the manager that owns it; files no manager has
+// loaded (e.g. a texture the game never requested) are ignored.
+static void apply_asset_hot_reload(
+    const std::vector<std::string>& changed_paths,
+    ShaderManager& shader_manager,
+    MeshManager& mesh_manager,
+    TextureManager& texture_manager
+) {
+    for (const std::string& path : changed_paths) {
+        const std::string extension = std::filesystem::path(path).extension().string();
+        const char* kind = nullptr;
+        uint32_t reloaded = 0;
+        if (extension == ".vert" || extension == ".frag") {
+            kind = "shader";
+            reloaded = shader_manager.reload_shader_file(path);
+        } else if (extension == ".obj") {
+            kind = "mesh";
+            reloaded = mesh_manager.reload_obj_mesh_file(path);
+        } else if (texture_manager.has_texture(path)) {
+            kind = "texture";
+            reloaded = texture_manager.reload_texture(path) != 0 ? 1 : 0;
+        }
+        if (kind) {
+            std::cout << "[asset.hot_reload] kind=" << kind
+                      << " path=" << path
+                      << " reloaded=" << reloaded << std::endl;
+        }
+    }
+}
+#endif
+
 int main() {
     g_vtable = get_miyabi_vtable();
     if (g_vtable.abi_version != MIYABI_ABI_VERSION) {
@@ -191,20 +267,35 @@ int main() {
 
     // --- Renderer Infrastructure Setup ---
     ShaderManager shader_manager;
+    // Before any request so every program, including reloads, gets them.
+    shader_manager.set_uniform_block_binding("FrameBlock", FRAME_BLOCK_BINDING);
+    shader_manager.set_uniform_block_binding("MaterialBlock", MATERIAL_BLOCK_BINDING);
+    const char* shader_cache_dir = std::getenv("MIYABI_SHADER_CACHE_DIR");
+    shader_manager.enable_program_cache(
+        shader_cache_dir && shader_cache_dir[0] != '\0' ? shader_cache_dir : "shader_cache",
+        (ShaderManager::ProcLoader)glfwGetProcAddress
+    );
+    shader_manager.enable_parallel_compile((ShaderManager::ProcLoader)glfwGetProcAddress);
+    const double shader_requests_start = glfwGetTime();
     MeshManager mesh_manager;
     MaterialManager material_manager;
     TextureManager texture_manager;
     FontManager font_manager;
-    font_manager.load_font("assets/MPLUS1p-Regular.ttf", 48);
+    // SDF glyphs: one 32px atlas serves every HUD size via TextRenderer scaling.
+    font_manager.load_font("assets/MPLUS1p-Regular.ttf", 32, FontRenderMode::Sdf);
     TextRenderer text_renderer(&shader_manager, &font_manager);
 
-    uint32_t textured_shader_id = shader_manager.load_shader("core/src/shaders/textured.vert", "core/src/shaders/textured.frag");
+    // Both materials share the standard uber-shader; unlit 2D sprites skip
+    // the lighting code entirely.
+    uint32_t textured_shader_id = shader_manager.request_permutation(
+        STANDARD_VERTEX_SHADER_PATH, STANDARD_FRAGMENT_SHADER_PATH, SHADER_FEATURE_NONE);
     if (textured_shader_id == 0) {
         glfwTerminate();
         return -1;
     }
     uint32_t lit_textured_shader_id =
-        shader_manager.load_shader("core/src/shaders/lit_textured.vert", "core/src/shaders/lit_textured.frag");
+        shader_manager.request_permutation(
+            STANDARD_VERTEX_SHADER_PATH, STANDARD_FRAGMENT_SHADER_PATH, SHADER_FEATURE_LIGHTING);
     if (lit_textured_shader_id == 0) {
         glfwTerminate();
         return -1;
@@ -223,20 +314,30 @@ int main() {
         glfwTerminate();
         return -1;
     }
-    uint32_t textured_material_id = material_manager.create_material(textured_shader_id);
+    uint32_t textured_material_id =
+        material_manager.create_material(textured_shader_id, MATERIAL_STATE_ALPHA_BLEND);
     if (textured_material_id != MATERIAL_ID_TEXTURED_2D) {
         std::cerr << "Unexpected 2D material ID. expected=" << MATERIAL_ID_TEXTURED_2D
                   << " actual=" << textured_material_id << std::endl;
         glfwTerminate();
         return -1;
     }
-    uint32_t lit_material_id = material_manager.create_material(lit_textured_shader_id);
+    uint32_t lit_material_id = material_manager.create_material(
+        lit_textured_shader_id, MATERIAL_STATE_DEPTH_TEST | MATERIAL_STATE_ALPHA_BLEND);
     if (lit_material_id != MATERIAL_ID_LIT_TEXTURED_3D) {
         std::cerr << "Unexpected 3D lit material ID. expected=" << MATERIAL_ID_LIT_TEXTURED_3D
                   << " actual=" << lit_material_id << std::endl;
         glfwTerminate();
         return -1;
     }
+    MaterialParams textured_params;
+    textured_params.alpha_cutoff = DEFAULT_ALPHA_CUTOFF;
+    material_manager.set_params(textured_material_id, textured_params);
+    MaterialParams lit_params;
+    lit_params.ambient_strength = 0.35f;
+    lit_params.diffuse_strength = 0.85f;
+    lit_params.alpha_cutoff = DEFAULT_ALPHA_CUTOFF;
+    material_manager.set_params(lit_material_id, lit_params);
 
     const GLMesh* quad_mesh = mesh_manager.get_mesh(quad_mesh_id);
     if (!quad_mesh) {
@@ -258,8 +359,6 @@ int main() {
     const DirectionalLight directional_light{
         glm::normalize(glm::vec3(-0.45f, -1.0f, -0.35f)),
         glm::vec3(1.0f, 0.98f, 0.92f),
-        0.35f,
-        0.85f,
     };
 
     Game* miyabi_game = g_vtable.create_game();
@@ -287,16 +386,63 @@ int main() {
     // Process any initial asset load commands.
     process_asset_commands(miyabi_game, texture_manager, true);
 
+#ifdef MIYABI_ASSET_HOT_RELOAD
+    // Debounced so an editor's multi-step save triggers a single reload.
+    AssetWatcher asset_watcher({ "assets", "core/src/shaders" }, std::chrono::milliseconds(150));
+    asset_watcher.start();
+#endif
+
     InputState input_state;
+    bool shader_startup_reported = false;
+    int frames_until_shaders_ready = 0;
+    int exit_code = 0;
 
 #ifdef MIYABI_PROFILE
     // Variables for performance monitoring
     double lastTime = glfwGetTime();
     int nbFrames = 0;
+    miyabi::profiler::GpuProfiler gpu_profiler;
+    gpu_profiler.init();
+    // Per-batch GPU scopes are opt-in: they add two queries per batch.
+    const char* gpu_profile_batches_env = std::getenv("MIYABI_GPU_PROFILE_BATCHES");
+    const bool gpu_profile_batches =
+        gpu_profile_batches_env && std::string(gpu_profile_batches_env) == "1";
+    const char* frame_budget_env = std::getenv("MIYABI_FRAME_BUDGET_MS");
+    const double frame_budget_ms = frame_budget_env && std::atof(frame_budget_env) > 0.0
+        ? std::atof(frame_budget_env)
+        : DEFAULT_FRAME_BUDGET_MS;
+    miyabi::profiler::FrameStats frame_stats(frame_budget_ms);
+    double last_frame_start = glfwGetTime();
+    // Chrome trace capture of all profiler scopes: MIYABI_TRACE_CAPTURE=<frames>
+    // captures from startup, F9 captures the next TRACE_CAPTURE_DEFAULT_FRAMES.
+    int trace_capture_count = 0;
+    bool trace_key_was_down = false;
+    const char* trace_capture_env = std::getenv("MIYABI_TRACE_CAPTURE");
+    if (trace_capture_env) {
+        const int frames = std::atoi(trace_capture_env);
+        if (frames > 0) {
+            start_trace_capture(static_cast<uint32_t>(frames), trace_capture_count);
+        }
+    }
 #endif
 
     // --- Render Loop ---
     while (!glfwWindowShouldClose(window)) {
+#ifdef MIYABI_PROFILE
+        // Drains last frame's scope events, including the Frame scope itself.
+        miyabi::profiler::Profiler::instance().collect();
+        const double frame_start = glfwGetTime();
+        const double frame_ms = (frame_start - last_frame_start) * 1000.0;
+        last_frame_start = frame_start;
+        if (frame_stats.add_frame(frame_ms)) {
+            log_frame_hitch(frame_stats, frame_ms);
+        }
+        const bool trace_key_down = glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS;
+        if (trace_key_down && !trace_key_was_down) {
+            start_trace_capture(TRACE_CAPTURE_DEFAULT_FRAMES, trace_capture_count);
+        }
+        trace_key_was_down = trace_key_down;
+#endif
         MIYABI_PROFILE_SCOPE("Frame");
 #ifdef MIYABI_PROFILE
         // Measure time
@@ -307,6 +453,51 @@ int main() {
             std::string title = "MIYABI Engine - " + std::to_string(nbFrames) + " FPS (" + std::to_string(msPerFrame) + " ms/frame)";
             glfwSetWindowTitle(window, title.c_str());
 
+            const TextRenderStats& text_stats = text_renderer.get_stats();
+            std::cout << "[renderer.text] draw_calls=" << text_stats.draw_calls
+                      << " vertices=" << text_stats.vertices
+                      << " glyphs=" << text_stats.glyphs
+                      << " strings=" << text_stats.strings
+                      << " layout_hits=" << text_stats.layout_cache_hits
+                      << " layout_misses=" << text_stats.layout_cache_misses
+                      << std::endl;
+
+            for (const auto& scope : miyabi::profiler::Profiler::instance().report()) {
+                std::cout << "[profile] thread=" << scope.thread
+                          << " scope=" << scope.path
+                          << " avg_ms=" << scope.window.avg_ms
+                          << " min_ms=" << scope.window.min_ms
+                          << " p95_ms=" << scope.window.p95_ms
+                          << " max_ms=" << scope.window.max_ms
+                          << " samples=" << scope.window.iterations
+                          << std::endl;
+            }
+            for (const auto& counter : miyabi::profiler::Profiler::instance().counters()) {
+                std::cout << "[profile] counter=" << counter.name
+                          << " value=" << counter.value
+                          << std::endl;
+            }
+
+            const auto frame_times = frame_stats.window().percentiles();
+            std::cout << "[frame.stats] frames=" << frame_times.frames
+                      << " p50_ms=" << frame_times.p50_ms
+                      << " p95_ms=" << frame_times.p95_ms
+                      << " p99_ms=" << frame_times.p99_ms
+                      << " max_ms=" << frame_times.max_ms
+                      << " hitches=" << frame_stats.window_hitches()
+                      << std::endl;
+            frame_stats.reset_window_hitches();
+
+            // GPU execution next to the CPU time spent submitting the same scope.
+            for (const auto& scope : gpu_profiler.report()) {
+                std::cout << "[renderer.gpu] scope=" << scope.name
+                          << " gpu_avg_ms=" << scope.gpu.avg_ms
+                          << " gpu_p95_ms=" << scope.gpu.p95_ms
+                          << " cpu_avg_ms=" << scope.cpu.avg_ms
+                          << " samples=" << scope.gpu.iterations
+                          << std::endl;
+            }
+
             nbFrames = 0;
             lastTime += 1.0;
         }
@@ -350,8 +541,46 @@ int main() {
             process_asset_commands(miyabi_game, texture_manager, false);
         }
 
+#ifdef MIYABI_ASSET_HOT_RELOAD
+        {
+            MIYABI_PROFILE_SCOPE("AssetHotReload");
+            apply_asset_hot_reload(asset_watcher.poll_changes(), shader_manager, mesh_manager, texture_manager);
+        }
+#endif
+
+        // Programs submitted for parallel compile become usable here as the
+        // driver finishes them; until then their materials are skipped.
+        shader_manager.poll_pending();
+        if (shader_manager.get_status(textured_shader_id) == ShaderStatus::Failed ||
+            shader_manager.get_status(lit_textured_shader_id) == ShaderStatus::Failed) {
+            std::cerr << "Required shader program failed to build." << std::endl;
+            exit_code = -1;
+            break;
+        }
+        if (!shader_startup_reported) {
+            ++frames_until_shaders_ready;
+            if (shader_manager.pending_count() == 0) {
+                // Run twice to compare: the first (cold) launch compiles and
+                // stores, the second (warm) one should report only cache hits.
+                const ShaderLoadStats& shader_stats = shader_manager.get_load_stats();
+                std::cout << "[renderer.shader] startup programs=" << shader_stats.programs
+                          << " cache_hits=" << shader_stats.cache_hits
+                          << " cache_misses=" << shader_stats.cache_misses
+                          << " cache_stores=" << shader_stats.cache_stores
+                          << " parallel=" << shader_stats.parallel_submits
+                          << " load_ms=" << shader_stats.load_ms
+                          << " ready_ms=" << (glfwGetTime() - shader_requests_start) * 1000.0
+                          << " ready_frame=" << frames_until_shaders_ready
+                          << std::endl;
+                shader_startup_reported = true;
+            }
+        }
+
         {
             MIYABI_PROFILE_SCOPE("Render");
+#ifdef MIYABI_PROFILE
+            gpu_profiler.begin_frame();
+#endif
             glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -370,87 +599,83 @@ int main() {
                 }
             }
 
+            // Parameter blocks are uploaded only when a material changed.
+            material_manager.upload_material_blocks();
+            uint32_t applied_render_state = MATERIAL_STATE_ALPHA_BLEND;
+            glDisable(GL_DEPTH_TEST);
+
             const auto render_batches = [&](std::vector<RenderableObject>& pass_renderables,
                                             const glm::mat4& projection,
-                                            const glm::mat4& view,
-                                            bool enable_depth_test) {
+                                            const glm::mat4& view) {
                 if (pass_renderables.empty()) {
                     return;
                 }
 
-                if (enable_depth_test) {
-                    glEnable(GL_DEPTH_TEST);
-                } else {
-                    glDisable(GL_DEPTH_TEST);
-                }
+                FrameParams frame_params;
+                frame_params.view = view;
+                frame_params.projection = projection;
+                frame_params.light_direction = glm::vec4(directional_light.direction, 0.0f);
+                frame_params.light_color = glm::vec4(directional_light.color, 1.0f);
+                material_manager.upload_frame_params(frame_params);
 
-                sort_renderables_for_batching(pass_renderables);
+                // Sort keys group materials by render state, then shader, so
+                // program and state switches happen as rarely as possible.
+                sort_renderables_by_material_key(pass_renderables, material_manager.get_sort_keys());
                 const std::vector<MaterialMeshBatch> material_mesh_batches =
                     build_material_mesh_batches(pass_renderables);
 
+                uint32_t bound_program_id = 0;
+                GLint material_index_location = -1;
                 for (const auto& material_mesh_batch : material_mesh_batches) {
                     Material* material = material_manager.get_material(material_mesh_batch.material_id);
                     if (!material) {
                         continue;
                     }
-                    shader_manager.use_shader(material->shader_id);
+                    // 0 while the program is still compiling in the background.
                     uint32_t program_id = shader_manager.get_program_id(material->shader_id);
-
-                    glUniformMatrix4fv(
-                        glGetUniformLocation(program_id, "u_projection"),
-                        1,
-                        GL_FALSE,
-                        &projection[0][0]
-                    );
-                    glUniformMatrix4fv(
-                        glGetUniformLocation(program_id, "u_view"),
-                        1,
-                        GL_FALSE,
-                        &view[0][0]
-                    );
-                    glUniform1i(glGetUniformLocation(program_id, "u_texture"), 0);
-                    set_vec3_uniform_if_present(
-                        program_id,
-                        "u_lightDirection",
-                        directional_light.direction
-                    );
-                    set_vec3_uniform_if_present(
-                        program_id,
-                        "u_lightColor",
-                        directional_light.color
-                    );
-                    set_float_uniform_if_present(
-                        program_id,
-                        "u_ambientStrength",
-                        directional_light.ambient_strength
-                    );
-                    set_float_uniform_if_present(
-                        program_id,
-                        "u_diffuseStrength",
-                        directional_light.diffuse_strength
-                    );
+                    if (program_id == 0) {
+                        continue;
+                    }
+                    apply_material_render_state(material->render_state, applied_render_state);
+                    if (program_id != bound_program_id) {
+                        shader_manager.use_shader(material->shader_id);
+                        glUniform1i(glGetUniformLocation(program_id, "u_texture"), 0);
+                        material_index_location = glGetUniformLocation(program_id, "u_materialIndex");
+                        bound_program_id = program_id;
+                    }
+                    // The material switch itself: one index into MaterialBlock.
+                    glUniform1i(material_index_location, static_cast<GLint>(material->block_index));
 
                     const GLMesh* batch_mesh = mesh_manager.get_mesh(material_mesh_batch.mesh_id);
                     if (!batch_mesh) {
                         continue;
                     }
                     mesh_manager.bind_mesh(material_mesh_batch.mesh_id);
+#ifdef MIYABI_PROFILE
+                    if (gpu_profile_batches) {
+                        gpu_profiler.begin_scope(
+                            "material=" + std::to_string(material_mesh_batch.material_id) +
+                            ",mesh=" + std::to_string(material_mesh_batch.mesh_id));
+                    }
+#endif
 
                     const size_t batch_end =
                         material_mesh_batch.start_index + material_mesh_batch.instance_count;
-                    std::unordered_map<uint32_t, std::vector<const RenderableObject*>> textured_batches;
-                    for (size_t i = material_mesh_batch.start_index; i < batch_end; ++i) {
-                        textured_batches[pass_renderables[i].texture_id].push_back(&pass_renderables[i]);
-                    }
-
-                    for (const auto& [texture_id, textured_batch] : textured_batches) {
-                        if (textured_batch.empty()) {
-                            continue;
+                    // Instances are sorted by texture within the batch, so each
+                    // texture run is contiguous and no per-frame map is needed.
+                    size_t run_start = material_mesh_batch.start_index;
+                    while (run_start < batch_end) {
+                        const uint32_t texture_id = pass_renderables[run_start].texture_id;
+                        size_t run_end = run_start + 1;
+                        while (run_end < batch_end && pass_renderables[run_end].texture_id == texture_id) {
+                            ++run_end;
                         }
+                        const size_t run_count = run_end - run_start;
 
                         std::vector<glm::mat4> model_matrices;
-                        model_matrices.reserve(textured_batch.size());
-                        for (const auto* obj : textured_batch) {
+                        model_matrices.reserve(run_count);
+                        for (size_t i = run_start; i < run_end; ++i) {
+                            const RenderableObject* obj = &pass_renderables[i];
                             glm::mat4 model = glm::mat4(1.0f);
                             model = glm::translate(
                                 model,
@@ -470,7 +695,7 @@ int main() {
                         glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
                         glBufferData(
                             GL_ARRAY_BUFFER,
-                            textured_batch.size() * sizeof(glm::mat4),
+                            run_count * sizeof(glm::mat4),
                             model_matrices.data(),
                             GL_DYNAMIC_DRAW);
 
@@ -480,8 +705,14 @@ int main() {
                             batch_mesh->element_count,
                             GL_UNSIGNED_INT,
                             0,
-                            textured_batch.size());
+                            run_count);
+                        run_start = run_end;
+                    }
+#ifdef MIYABI_PROFILE
+                    if (gpu_profile_batches) {
+                        gpu_profiler.end_scope();
                     }
+#endif
                 }
             };
 
@@ -513,29 +744,42 @@ int main() {
             );
             const glm::mat4 view_2d = glm::mat4(1.0f);
 
-            render_batches(renderables_3d, projection_3d, view_3d, true);
-            render_batches(renderables_2d, projection_2d, view_2d, false);
+            {
+                MIYABI_GPU_PROFILE_SCOPE(gpu_profiler, "Pass3D");
+                render_batches(renderables_3d, projection_3d, view_3d);
+            }
+            {
+                MIYABI_GPU_PROFILE_SCOPE(gpu_profiler, "Pass2D");
+                render_batches(renderables_2d, projection_2d, view_2d);
+            }
             
             glBindVertexArray(0);
             glDisable(GL_DEPTH_TEST);
+            glEnable(GL_BLEND);
 
-            // Render text from commands
+            // Render text from commands: every string is batched, then drawn per atlas page.
             TextCommandSlice text_commands_slice = g_vtable.get_text_commands(miyabi_game);
+            font_manager.begin_frame();
+            text_renderer.begin_frame();
+            const float font_pixel_size = static_cast<float>(font_manager.get_pixel_size());
             for (const auto& command : text_commands_slice) {
-                const char* c_text = g_vtable.get_text_command_text_cstring(&command);
-                std::string text(c_text);
-                g_vtable.free_cstring((char*)c_text);
+                // Borrowed from Rust until the next update_game; no copy, no free.
+                const MiyabiStringView text = g_vtable.get_text_command_text_view(&command);
 
-                float scale = command.font_size / 48.0f; // Font atlas was loaded with size 48
+                float scale = command.font_size / font_pixel_size;
 
-                text_renderer.render_text(
-                    text,
+                text_renderer.queue_text(
+                    std::string_view(text.ptr, text.len),
                     command.position.x,
                     command.position.y,
                     scale,
-                    glm::vec3(command.color.x, command.color.y, command.color.z)
+                    glm::vec4(command.color.x, command.color.y, command.color.z, command.color.w)
                 );
             }
+            {
+                MIYABI_GPU_PROFILE_SCOPE(gpu_profiler, "PassText");
+                text_renderer.flush(projection_2d);
+            }
         }
 
         glfwSwapBuffers(window);
@@ -547,8 +791,34 @@ int main() {
     g_vtable.destroy_game(miyabi_game);
     shutdown_engine_systems();
 
+#ifdef MIYABI_PROFILE
+    // Same schema as the logic perf baseline, so check_perf_regression.py
+    // can compare pass timings against a baseline file.
+    const char* gpu_perf_output = std::getenv("MIYABI_GPU_PERF_OUTPUT");
+    if (gpu_perf_output && gpu_perf_output[0] != '\0' && gpu_profiler.write_json(gpu_perf_output)) {
+        std::cout << "[renderer.gpu] report=" << gpu_perf_output
+                  << " dropped_results=" << gpu_profiler.dropped_results() << std::endl;
+    }
+    // Query objects go with the context, like the other GL resources.
+    gpu_profiler.shutdown();
+
+    const auto frame_summary = frame_stats.total().percentiles();
+    std::cout << "[frame.summary] frames=" << frame_summary.frames
+              << " p50_ms=" << frame_summary.p50_ms
+              << " p95_ms=" << frame_summary.p95_ms
+              << " p99_ms=" << frame_summary.p99_ms
+              << " max_ms=" << frame_summary.max_ms
+              << " hitches=" << frame_stats.hitches()
+              << " budget_ms=" << frame_stats.budget_ms()
+              << std::endl;
+    const char* frame_stats_output = std::getenv("MIYABI_FRAME_STATS_OUTPUT");
+    if (frame_stats_output && frame_stats_output[0] != '\0' && frame_stats.write_json(frame_stats_output)) {
+        std::cout << "[frame.summary] report=" << frame_stats_output << std::endl;
+    }
+#endif
+
     glfwTerminate();
-    return 0;
+    return exit_code;
 }
 
 // --- Utility Functions ---
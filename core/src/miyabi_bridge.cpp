@@ -1,6 +1,7 @@
 // This file is used by cxx to bridge C++ and Rust.
 #include "miyabi/bridge.h"
 #include "miyabi_logic_cxx/lib.h" // For definitions of shared types like Vec2
+#include "jobs/JobSystem.hpp"
 #include "physics/PhysicsManager.hpp"
 
 // The miniaudio implementation must be in exactly one C++ file.
@@ -9,8 +10,12 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 // --- Global Engine Systems ---
 ma_engine g_engine;
@@ -18,6 +23,11 @@ ma_sound_group g_bgm_group;
 ma_sound_group g_se_group;
 ma_sound g_bgm_sound;
 miyabi::physics::PhysicsManager g_physics_manager;
+// Steps physics partitions in parallel; only created when there is more
+// than one partition.
+std::unique_ptr<miyabi::jobs::JobSystem> g_job_system;
+// Reused by save_physics_snapshot().
+std::vector<uint8_t> g_physics_snapshot;
 std::atomic<bool> g_audio_ready{false};
 std::atomic<bool> g_bgm_group_ready{false};
 std::atomic<bool> g_se_group_ready{false};
@@ -125,6 +135,19 @@ miyabi::physics::PhysicsManager::BodyId create_static_box_body(float x, float y,
     return g_physics_manager.create_static_box(x, y, width, height);
 }
 
+bool destroy_body(miyabi::physics::PhysicsManager::BodyId id) {
+    return g_physics_manager.destroy_body(id);
+}
+
+size_t create_bodies(rust::Slice<const BodyDesc> descs, rust::Slice<const Vec2> vertices, rust::Slice<uint64_t> out_ids) {
+    const size_t count = descs.size() < out_ids.size() ? descs.size() : out_ids.size();
+    return g_physics_manager.create_bodies(descs.data(), count, vertices.data(), vertices.size(), out_ids.data());
+}
+
+size_t destroy_bodies(rust::Slice<const uint64_t> ids) {
+    return g_physics_manager.destroy_bodies(ids.data(), ids.size());
+}
+
 Vec2 get_body_position(miyabi::physics::PhysicsManager::BodyId id) {
     return g_physics_manager.get_body_position(id);
 }
@@ -137,6 +160,57 @@ rust::Slice<const CollisionEvent> get_collision_events() {
     );
 }
 
+rust::Slice<const BodyState> get_body_states() {
+    const auto& states = g_physics_manager.get_body_states();
+    return rust::Slice<const BodyState>(states.data(), states.size());
+}
+
+size_t fill_body_states(rust::Slice<const uint64_t> ids, rust::Slice<BodyState> out) {
+    const size_t count = ids.size() < out.size() ? ids.size() : out.size();
+    return g_physics_manager.fill_body_states(ids.data(), count, out.data());
+}
+
+rust::Slice<const BodyState> get_moved_body_states() {
+    const auto& states = g_physics_manager.get_moved_body_states();
+    return rust::Slice<const BodyState>(states.data(), states.size());
+}
+
+size_t raycast_bodies(rust::Slice<const RayCastQuery> queries, rust::Slice<QueryHit> out_hits) {
+    const size_t count = queries.size() < out_hits.size() ? queries.size() : out_hits.size();
+    return g_physics_manager.raycast(queries.data(), count, out_hits.data());
+}
+
+size_t shape_cast_bodies(rust::Slice<const ShapeCastQuery> queries, rust::Slice<QueryHit> out_hits) {
+    const size_t count = queries.size() < out_hits.size() ? queries.size() : out_hits.size();
+    return g_physics_manager.shape_cast(queries.data(), count, out_hits.data());
+}
+
+size_t query_aabb_bodies(rust::Slice<const AabbQuery> queries, rust::Slice<uint64_t> out_ids, rust::Slice<QueryRange> out_ranges) {
+    const size_t count = queries.size() < out_ranges.size() ? queries.size() : out_ranges.size();
+    return g_physics_manager.query_aabb(queries.data(), count, out_ids.data(), out_ids.size(), out_ranges.data());
+}
+
+rust::Slice<const uint8_t> save_physics_snapshot() {
+    g_physics_manager.save_snapshot(g_physics_snapshot);
+    return rust::Slice<const uint8_t>(g_physics_snapshot.data(), g_physics_snapshot.size());
+}
+
+bool restore_physics_snapshot(rust::Slice<const uint8_t> data) {
+    return g_physics_manager.restore_snapshot(data.data(), data.size());
+}
+
+bool set_physics_step_config(const PhysicsStepConfig& config) {
+    return g_physics_manager.set_step_config(config);
+}
+
+PhysicsStepConfig get_physics_step_config() {
+    return g_physics_manager.step_config();
+}
+
+bool set_body_bullet(uint64_t id, bool bullet) {
+    return g_physics_manager.set_bullet(id, bullet);
+}
+
 // --- Engine System Lifecycle ---
 
 void init_engine_systems() {
@@ -162,8 +236,38 @@ void init_engine_systems() {
         }
     }
 
-    // Init Physics
-    g_physics_manager.init();
+    // Init Physics. MIYABI_PHYSICS_PARTITIONS splits the world into
+    // independent partitions stepped on the job system. Partitions are
+    // opt-in per body (BodyDesc::partition): the shipped scenes put every
+    // body in partition 0, so for them extra partitions stay empty;
+    // MIYABI_PHYSICS_DETERMINISTIC=0 trades stable collision event order
+    // for dynamic scheduling.
+    size_t physics_partitions = 1;
+    if (const char* partitions_env = std::getenv("MIYABI_PHYSICS_PARTITIONS")) {
+        const int parsed = std::atoi(partitions_env);
+        if (parsed > 0) {
+            physics_partitions = static_cast<size_t>(parsed);
+        }
+    }
+    const char* deterministic_env = std::getenv("MIYABI_PHYSICS_DETERMINISTIC");
+    const bool physics_deterministic = !deterministic_env || std::string(deterministic_env) != "0";
+    g_physics_manager.init(physics_partitions);
+    g_physics_manager.set_deterministic(physics_deterministic);
+    // MIYABI_PHYSICS_BUDGET_MS=<ms> turns on adaptive step quality.
+    if (const char* budget_env = std::getenv("MIYABI_PHYSICS_BUDGET_MS")) {
+        PhysicsStepConfig step_config = g_physics_manager.step_config();
+        step_config.budget_ms = static_cast<float>(std::atof(budget_env));
+        g_physics_manager.set_step_config(step_config);
+    }
+    if (physics_partitions > 1) {
+        g_job_system = std::make_unique<miyabi::jobs::JobSystem>();
+        g_physics_manager.set_job_system(g_job_system.get());
+    }
+    std::cout << "[physics.init] partitions=" << physics_partitions
+              << " (opt-in per BodyDesc::partition)"
+              << " workers=" << (g_job_system ? g_job_system->worker_count() : 0)
+              << " deterministic=" << (physics_deterministic ? 1 : 0)
+              << " budget_ms=" << g_physics_manager.step_config().budget_ms << std::endl;
 }
 
 void shutdown_engine_systems() {
@@ -181,6 +285,9 @@ void shutdown_engine_systems() {
         ma_engine_uninit(&g_engine);
         g_audio_ready.store(false, std::memory_order_release);
     }
+
+    g_physics_manager.set_job_system(nullptr);
+    g_job_system.reset();
 }
 
 void step_engine_systems() {
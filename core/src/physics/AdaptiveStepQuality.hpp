@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace miyabi {
+namespace physics {
+
+// Solver work of one physics step: sub-steps and the iterations of each.
+struct StepQuality {
+    uint32_t sub_steps;
+    int32_t velocity_iterations;
+    int32_t position_iterations;
+};
+
+// Budget-driven step quality. Level 0 is the configured (full) quality;
+// each level above it drops one notch: sub-steps first, then velocity
+// iterations, then position iterations, none below one. Every step over
+// the budget raises the level; RECOVER_STEPS consecutive steps under
+// RECOVER_FRACTION of the budget lower it again. Steps in between reset
+// that run.
+class AdaptiveStepQuality {
+public:
+    static constexpr uint32_t RECOVER_STEPS = 60;
+    static constexpr double RECOVER_FRACTION = 0.6;
+
+    // `full` must have at least one of everything. A budget of 0 turns
+    // adaptation off. Starts again from full quality.
+    void configure(const StepQuality& full, double budget_ms) {
+        m_full = full;
+        m_budget_ms = budget_ms;
+        m_level = 0;
+        m_calm_steps = 0;
+        m_current = full;
+    }
+
+    // Feeds the duration of the step that just ran; current() is the
+    // quality for the next one. Ignored without a budget.
+    void record_step(double step_ms) {
+        if (m_budget_ms <= 0.0) {
+            return;
+        }
+        if (step_ms > m_budget_ms) {
+            m_calm_steps = 0;
+            if (m_level < max_level()) {
+                ++m_level;
+            }
+        } else if (step_ms < m_budget_ms * RECOVER_FRACTION) {
+            if (m_level > 0 && ++m_calm_steps >= RECOVER_STEPS) {
+                --m_level;
+                m_calm_steps = 0;
+            }
+        } else {
+            m_calm_steps = 0;
+        }
+        m_current = quality_for_level(m_full, m_level);
+    }
+
+    const StepQuality& current() const { return m_current; }
+    uint32_t level() const { return m_level; }
+    bool adaptive() const { return m_budget_ms > 0.0; }
+
+    // Level at which every setting is down to one.
+    uint32_t max_level() const {
+        return (m_full.sub_steps - 1) + static_cast<uint32_t>(m_full.velocity_iterations - 1)
+            + static_cast<uint32_t>(m_full.position_iterations - 1);
+    }
+
+    static StepQuality quality_for_level(const StepQuality& full, uint32_t level) {
+        StepQuality quality = full;
+        const uint32_t sub_step_drop = std::min(level, quality.sub_steps - 1);
+        quality.sub_steps -= sub_step_drop;
+        level -= sub_step_drop;
+        const uint32_t velocity_drop = std::min(level, static_cast<uint32_t>(quality.velocity_iterations - 1));
+        quality.velocity_iterations -= static_cast<int32_t>(velocity_drop);
+        level -= velocity_drop;
+        const uint32_t position_drop = std::min(level, static_cast<uint32_t>(quality.position_iterations - 1));
+        quality.position_iterations -= static_cast<int32_t>(position_drop);
+        return quality;
+    }
+
+private:
+    StepQuality m_full{1, 6, 2};
+    StepQuality m_current{1, 6, 2};
+    double m_budget_ms = 0.0;
+    uint32_t m_level = 0;
+    uint32_t m_calm_steps = 0;
+};
+
+} // namespace physics
+} // namespace miyabi
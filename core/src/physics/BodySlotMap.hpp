@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace miyabi {
+namespace physics {
+
+// Maps generational 64-bit body ids to a dense index range [0, size()).
+// The map stores no values: PhysicsManager keeps its per-body arrays
+// (b2Body pointers, exported BodyState) parallel to the dense range and
+// mirrors every swap-remove, so iteration stays a linear walk.
+//
+// An id is `generation << 32 | (slot + 1)`. Generations start at 0, so the
+// first id handed out for each slot is 1, 2, 3, ... as before. Removing a
+// body bumps its slot's generation, so a stale id never resolves to the
+// body that later reuses the slot.
+class BodySlotMap {
+public:
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+    static constexpr uint32_t MAX_GENERATION = 0xFFFFFFFFu;
+
+    static uint32_t slot_of(uint64_t id) { return static_cast<uint32_t>(id) - 1u; }
+    static uint32_t generation_of(uint64_t id) { return static_cast<uint32_t>(id >> 32); }
+
+    // Returns the new id; its dense index is size() - 1.
+    uint64_t insert() {
+        uint32_t slot;
+        if (!m_free_slots.empty()) {
+            slot = m_free_slots.back();
+            m_free_slots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({ 0, 0 });
+        }
+        m_slots[slot].dense_index = static_cast<uint32_t>(m_dense_ids.size());
+        const uint64_t id = make_id(slot);
+        m_dense_ids.push_back(id);
+        return id;
+    }
+
+    // Dense index of `id`, or NPOS if it is 0, unknown or stale.
+    size_t dense_index(uint64_t id) const {
+        if (static_cast<uint32_t>(id) == 0) {
+            return NPOS;
+        }
+        const uint32_t slot = slot_of(id);
+        if (slot >= m_slots.size()) {
+            return NPOS;
+        }
+        const Slot& entry = m_slots[slot];
+        if (entry.generation != generation_of(id) || entry.dense_index >= m_dense_ids.size()
+            || m_dense_ids[entry.dense_index] != id) {
+            return NPOS;
+        }
+        return entry.dense_index;
+    }
+
+    bool contains(uint64_t id) const { return dense_index(id) != NPOS; }
+
+    // Removes `id` by moving the last dense entry into its place. On success
+    // `removed_index` is the vacated index; the caller moves element
+    // size() (the old last index) of its parallel arrays there and pops.
+    bool remove(uint64_t id, size_t& removed_index) {
+        const size_t index = dense_index(id);
+        if (index == NPOS) {
+            return false;
+        }
+        const uint64_t last_id = m_dense_ids.back();
+        m_dense_ids[index] = last_id;
+        m_slots[slot_of(last_id)].dense_index = static_cast<uint32_t>(index);
+        m_dense_ids.pop_back();
+        release_slot(slot_of(id));
+        removed_index = index;
+        return true;
+    }
+
+    void clear() {
+        for (uint64_t id : m_dense_ids) {
+            release_slot(slot_of(id));
+        }
+        m_dense_ids.clear();
+    }
+
+    size_t size() const { return m_dense_ids.size(); }
+    uint64_t id_at(size_t dense_index) const { return m_dense_ids[dense_index]; }
+    // Slots ever allocated; bounded by the peak number of live bodies.
+    size_t slot_count() const { return m_slots.size(); }
+
+    // Snapshot support: a map is fully described by the generation of every
+    // slot, the free list (in reuse order) and the dense ids.
+    uint32_t generation_at(size_t slot) const { return m_slots[slot].generation; }
+    const std::vector<uint32_t>& free_slots() const { return m_free_slots; }
+
+    // Replaces the map with a saved one. Returns false, leaving the map
+    // unchanged, if the parts are inconsistent (an id whose generation or
+    // slot does not match, a slot that is both live and free, ...).
+    bool restore(const std::vector<uint32_t>& generations, const std::vector<uint32_t>& free_slots,
+                 const std::vector<uint64_t>& dense_ids) {
+        std::vector<Slot> slots(generations.size());
+        for (size_t i = 0; i < generations.size(); ++i) {
+            slots[i] = { NO_INDEX, generations[i] };
+        }
+        for (size_t index = 0; index < dense_ids.size(); ++index) {
+            const uint64_t id = dense_ids[index];
+            const uint32_t slot = slot_of(id);
+            if (static_cast<uint32_t>(id) == 0 || slot >= slots.size() || slots[slot].dense_index != NO_INDEX
+                || slots[slot].generation != generation_of(id)) {
+                return false;
+            }
+            slots[slot].dense_index = static_cast<uint32_t>(index);
+        }
+        std::vector<bool> freed(slots.size(), false);
+        for (uint32_t slot : free_slots) {
+            if (slot >= slots.size() || slots[slot].dense_index != NO_INDEX || freed[slot]
+                || slots[slot].generation == MAX_GENERATION) {
+                return false;
+            }
+            freed[slot] = true;
+        }
+        m_slots = std::move(slots);
+        m_free_slots = free_slots;
+        m_dense_ids = dense_ids;
+        return true;
+    }
+
+private:
+    static constexpr uint32_t NO_INDEX = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t dense_index;
+        uint32_t generation;
+    };
+
+    uint64_t make_id(uint32_t slot) const {
+        return (static_cast<uint64_t>(m_slots[slot].generation) << 32) | (static_cast<uint64_t>(slot) + 1u);
+    }
+
+    void release_slot(uint32_t slot) {
+        Slot& entry = m_slots[slot];
+        entry.dense_index = NO_INDEX;
+        // A slot whose generation would wrap is retired, never reused.
+        if (entry.generation < MAX_GENERATION) {
+            ++entry.generation;
+            m_free_slots.push_back(slot);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free_slots;
+    std::vector<uint64_t> m_dense_ids;
+};
+
+} // namespace physics
+} // namespace miyabi
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace miyabi {
+namespace physics {
+
+// Fixed-capacity, double-buffered event storage. One buffer is published
+// (read by the game, e.g. as a rust::Slice) while the next step writes the
+// other, so a borrowed view of the published events stays valid until the
+// following publish(). Both buffers are allocated by reserve(); writes
+// beyond the capacity are dropped and counted, never reallocated.
+template <typename T>
+class EventArena {
+public:
+    EventArena() = default;
+
+    // Discards all events and (re)allocates both buffers.
+    void reserve(size_t capacity) {
+        m_capacity = capacity;
+        for (std::vector<T>& buffer : m_buffers) {
+            buffer.clear();
+            buffer.reserve(capacity);
+        }
+        m_dropped = 0;
+        m_write_dropped = 0;
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+    // Starts a new write into the back buffer.
+    void begin_write() {
+        m_buffers[m_back].clear();
+        m_write_dropped = 0;
+    }
+
+    bool push(const T& event) {
+        std::vector<T>& buffer = m_buffers[m_back];
+        if (buffer.size() >= m_capacity) {
+            ++m_write_dropped;
+            return false;
+        }
+        buffer.push_back(event);
+        return true;
+    }
+
+    // Appends as many of `events` as fit; returns the number appended.
+    size_t append(const T* events, size_t count) {
+        std::vector<T>& buffer = m_buffers[m_back];
+        const size_t room = m_capacity - buffer.size();
+        const size_t appended = count < room ? count : room;
+        buffer.insert(buffer.end(), events, events + appended);
+        m_write_dropped += count - appended;
+        return appended;
+    }
+
+    // Makes the back buffer the published one.
+    void publish() {
+        m_back ^= 1u;
+        m_dropped = m_write_dropped;
+    }
+
+    const std::vector<T>& published() const { return m_buffers[m_back ^ 1u]; }
+    // Events dropped while writing the published buffer.
+    size_t dropped() const { return m_dropped; }
+
+private:
+    std::vector<T> m_buffers[2];
+    size_t m_back = 0;
+    size_t m_capacity = 0;
+    size_t m_dropped = 0;
+    size_t m_write_dropped = 0;
+};
+
+} // namespace physics
+} // namespace miyabi
@@ -1,28 +1,353 @@
 #include "physics/PhysicsManager.hpp"
 #include "miyabi_logic_cxx/lib.h" // For Vec2 and CollisionEvent definition
+#include "jobs/JobSystem.hpp"
+#include "profiler/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <tuple>
+#include <utility>
 
 namespace miyabi {
 namespace physics {
 
+namespace {
+// Box descriptor with the fixture defaults the single-body calls always
+// used (dynamic: density 1, friction 0.3; static: b2FixtureDef defaults).
+BodyDesc make_box_desc(BodyKind kind, float x, float y, float width, float height)
+{
+    BodyDesc desc{};
+    desc.kind = kind;
+    desc.shape = BodyShapeType::Box;
+    desc.position = {x, y};
+    desc.half_extents = {width / 2.0f, height / 2.0f};
+    desc.density = kind == BodyKind::Dynamic ? 1.0f : 0.0f;
+    desc.friction = kind == BodyKind::Dynamic ? 0.3f : 0.2f;
+    desc.restitution = 0.0f;
+    desc.category_bits = 0x0001;
+    desc.mask_bits = 0xFFFF;
+    desc.group_index = 0;
+    return desc;
+}
+
+bool is_positive_finite(float value)
+{
+    return std::isfinite(value) && value > 0.0f;
+}
+
+// b2PolygonShape::Set asserts when the hull has fewer than 3 points, so
+// reject polygons whose points are all (nearly) collinear up front.
+bool is_degenerate_polygon(const b2Vec2* points, size_t count)
+{
+    const float min_area = b2_linearSlop * b2_linearSlop;
+    for (size_t i = 1; i < count; ++i) {
+        for (size_t j = i + 1; j < count; ++j) {
+            const float area = b2Cross(points[i] - points[0], points[j] - points[0]);
+            if (area > min_area || area < -min_area) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr uint32_t NO_EVENT = 0xFFFFFFFFu;
+
+size_t contact_hash(const b2Contact* contact)
+{
+    // Contacts are block-allocated; drop the alignment bits before mixing.
+    const uint64_t bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(contact)) >> 4;
+    return static_cast<size_t>(bits * 0x9E3779B97F4A7C15ull >> 32);
+}
+
+// Fills the body ids and kind of a begin/end event; sensor events put the
+// sensor's body in bodyA. Returns false for bodies without an id.
+bool make_event(b2Contact* contact, bool begin, CollisionEvent& event)
+{
+    b2Fixture* fixture_a = contact->GetFixtureA();
+    b2Fixture* fixture_b = contact->GetFixtureB();
+    const bool sensor = fixture_a->IsSensor() || fixture_b->IsSensor();
+    if (sensor && !fixture_a->IsSensor()) {
+        std::swap(fixture_a, fixture_b);
+    }
+    const uintptr_t body_a_id = fixture_a->GetBody()->GetUserData().pointer;
+    const uintptr_t body_b_id = fixture_b->GetBody()->GetUserData().pointer;
+    // Ensure we have valid IDs before pushing an event
+    if (!body_a_id || !body_b_id) {
+        return false;
+    }
+    event = CollisionEvent{};
+    event.bodyA = static_cast<PhysicsManager::BodyId>(body_a_id);
+    event.bodyB = static_cast<PhysicsManager::BodyId>(body_b_id);
+    if (sensor) {
+        event.kind = begin ? CollisionEventKind::SensorBegin : CollisionEventKind::SensorEnd;
+    } else {
+        event.kind = begin ? CollisionEventKind::Begin : CollisionEventKind::End;
+    }
+    return true;
+}
+
+// Batches at least this large are spread over the job system, in chunks of
+// QUERY_CHUNK queries.
+constexpr size_t PARALLEL_QUERY_MIN = 64;
+constexpr size_t QUERY_CHUNK = 32;
+
+constexpr uint32_t MAX_SUB_STEPS = 16;
+
+bool passes_mask(const b2Fixture* fixture, uint16_t mask_bits)
+{
+    return (fixture->GetFilterData().categoryBits & mask_bits) != 0;
+}
+
+QueryHit make_hit(const b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction)
+{
+    return QueryHit{
+        static_cast<PhysicsManager::BodyId>(fixture->GetBody()->GetUserData().pointer),
+        {point.x, point.y},
+        {normal.x, normal.y},
+        fraction
+    };
+}
+
+// Keeps the closest fixture across every world it is passed to.
+class ClosestRayCallback : public b2RayCastCallback
+{
+public:
+    explicit ClosestRayCallback(uint16_t mask_bits) : m_mask_bits(mask_bits) {}
+
+    float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override
+    {
+        if (!passes_mask(fixture, m_mask_bits)) {
+            return -1.0f; // ignore and continue
+        }
+        if (!m_fixture || fraction < m_hit.fraction) {
+            m_fixture = fixture;
+            m_hit = make_hit(fixture, point, normal, fraction);
+        }
+        return fraction;
+    }
+
+    bool hit() const { return m_fixture != nullptr; }
+    const QueryHit& result() const { return m_hit; }
+
+private:
+    uint16_t m_mask_bits;
+    const b2Fixture* m_fixture = nullptr;
+    QueryHit m_hit{};
+};
+
+// Runs b2ShapeCast against every fixture whose AABB meets the swept query
+// AABB and keeps the earliest time of impact.
+class ClosestShapeCastCallback : public b2QueryCallback
+{
+public:
+    ClosestShapeCastCallback(const b2Shape& shape, const b2Transform& transform, const b2Vec2& translation, uint16_t mask_bits)
+        : m_transform(transform), m_translation(translation), m_mask_bits(mask_bits)
+    {
+        m_proxy.Set(&shape, 0);
+    }
+
+    bool ReportFixture(b2Fixture* fixture) override
+    {
+        if (!passes_mask(fixture, m_mask_bits)) {
+            return true;
+        }
+        const b2Shape* shape = fixture->GetShape();
+        for (int32 child = 0; child < shape->GetChildCount(); ++child) {
+            b2ShapeCastInput input;
+            input.proxyA.Set(shape, child);
+            input.transformA = fixture->GetBody()->GetTransform();
+            input.proxyB = m_proxy;
+            input.transformB = m_transform;
+            input.translationB = m_translation;
+            b2ShapeCastOutput output;
+            if (b2ShapeCast(&output, &input) && (!m_fixture || output.lambda < m_hit.fraction)) {
+                m_fixture = fixture;
+                m_hit = make_hit(fixture, output.point, output.normal, output.lambda);
+            }
+        }
+        return true;
+    }
+
+    bool hit() const { return m_fixture != nullptr; }
+    const QueryHit& result() const { return m_hit; }
+
+private:
+    b2DistanceProxy m_proxy;
+    b2Transform m_transform;
+    b2Vec2 m_translation;
+    uint16_t m_mask_bits;
+    const b2Fixture* m_fixture = nullptr;
+    QueryHit m_hit{};
+};
+
+// Writes overlapping body ids while there is room and counts all of them.
+class AabbOverlapCallback : public b2QueryCallback
+{
+public:
+    AabbOverlapCallback(const b2AABB& aabb, uint16_t mask_bits, PhysicsManager::BodyId* out, size_t capacity)
+        : m_aabb(aabb), m_mask_bits(mask_bits), m_out(out), m_capacity(capacity) {}
+
+    bool ReportFixture(b2Fixture* fixture) override
+    {
+        if (!passes_mask(fixture, m_mask_bits)) {
+            return true;
+        }
+        // The broadphase reports fattened AABBs; test the tight ones.
+        const int32 children = fixture->GetShape()->GetChildCount();
+        for (int32 child = 0; child < children; ++child) {
+            if (b2TestOverlap(fixture->GetAABB(child), m_aabb)) {
+                if (m_written < m_capacity) {
+                    m_out[m_written++] = static_cast<PhysicsManager::BodyId>(fixture->GetBody()->GetUserData().pointer);
+                }
+                ++m_found;
+                break;
+            }
+        }
+        return true;
+    }
+
+    size_t written() const { return m_written; }
+    size_t found() const { return m_found; }
+
+private:
+    b2AABB m_aabb;
+    uint16_t m_mask_bits;
+    PhysicsManager::BodyId* m_out;
+    size_t m_capacity;
+    size_t m_written = 0;
+    size_t m_found = 0;
+};
+} // namespace
+
 // --- MyContactListener Implementation ---
-MyContactListener::MyContactListener(std::vector<CollisionEvent>& events)
-    : m_events(events) {}
+MyContactListener::MyContactListener(size_t capacity)
+    : m_capacity(capacity), m_dropped(0), m_stamp(1), m_begin_count(0)
+{
+    m_events.reserve(capacity);
+    size_t slots = 16;
+    while (slots < capacity * 2) {
+        slots *= 2;
+    }
+    // Stamp 0 marks a slot free, so the table starts empty even when a
+    // world steps before the first begin_step().
+    m_begin_slots.assign(slots, BeginSlot{nullptr, 0, 0});
+}
+
+void MyContactListener::begin_step()
+{
+    m_events.clear();
+    m_dropped = 0;
+    m_begin_count = 0;
+    if (++m_stamp == 0) {
+        // Wrapped: forget every stamp so none look current.
+        for (BeginSlot& slot : m_begin_slots) {
+            slot.stamp = 0;
+        }
+        m_stamp = 1;
+    }
+}
+
+bool MyContactListener::push(const CollisionEvent& event)
+{
+    if (m_events.size() >= m_capacity) {
+        ++m_dropped;
+        return false;
+    }
+    m_events.push_back(event);
+    return true;
+}
+
+void MyContactListener::remember_begin(const b2Contact* contact, uint32_t event)
+{
+    const size_t mask = m_begin_slots.size() - 1;
+    size_t index = contact_hash(contact) & mask;
+    // At most `capacity` begins per step in a table of >= 2 * capacity.
+    while (m_begin_slots[index].stamp == m_stamp) {
+        index = (index + 1) & mask;
+    }
+    m_begin_slots[index] = BeginSlot{contact, event, m_stamp};
+    ++m_begin_count;
+}
+
+uint32_t MyContactListener::find_begin(const b2Contact* contact) const
+{
+    if (m_begin_count == 0) {
+        return NO_EVENT;
+    }
+    const size_t mask = m_begin_slots.size() - 1;
+    for (size_t index = contact_hash(contact) & mask; m_begin_slots[index].stamp == m_stamp;
+         index = (index + 1) & mask) {
+        if (m_begin_slots[index].contact == contact) {
+            return m_begin_slots[index].event;
+        }
+    }
+    return NO_EVENT;
+}
 
 void MyContactListener::BeginContact(b2Contact* contact)
 {
-    b2Body* bodyA = contact->GetFixtureA()->GetBody();
-    b2Body* bodyB = contact->GetFixtureB()->GetBody();
+    CollisionEvent event;
+    if (!make_event(contact, true, event)) {
+        return;
+    }
+    if (event.kind == CollisionEventKind::Begin) {
+        // The manifold is already evaluated when BeginContact runs.
+        b2WorldManifold manifold;
+        contact->GetWorldManifold(&manifold);
+        const int32 points = contact->GetManifold()->pointCount;
+        b2Vec2 point(0.0f, 0.0f);
+        for (int32 i = 0; i < points; ++i) {
+            point += manifold.points[i];
+        }
+        if (points > 0) {
+            point *= 1.0f / static_cast<float>(points);
+        }
+        event.point = {point.x, point.y};
+        event.normal = {manifold.normal.x, manifold.normal.y};
+    }
+    if (push(event) && event.kind == CollisionEventKind::Begin) {
+        remember_begin(contact, static_cast<uint32_t>(m_events.size() - 1));
+    }
+}
+
+void MyContactListener::EndContact(b2Contact* contact)
+{
+    CollisionEvent event;
+    if (make_event(contact, false, event)) {
+        push(event);
+    }
+}
 
-    uintptr_t body_a_id_ptr = bodyA->GetUserData().pointer;
-    uintptr_t body_b_id_ptr = bodyB->GetUserData().pointer;
+void MyContactListener::PreSolve(b2Contact* contact, const b2Manifold* /*oldManifold*/)
+{
+    const uint32_t index = find_begin(contact);
+    if (index == NO_EVENT) {
+        return;
+    }
+    // Relative velocity along the normal at first touch, positive when the
+    // bodies are closing.
+    CollisionEvent& event = m_events[index];
+    const b2Vec2 point(event.point.x, event.point.y);
+    const b2Vec2 normal(event.normal.x, event.normal.y);
+    const b2Vec2 velocity_a = contact->GetFixtureA()->GetBody()->GetLinearVelocityFromWorldPoint(point);
+    const b2Vec2 velocity_b = contact->GetFixtureB()->GetBody()->GetLinearVelocityFromWorldPoint(point);
+    event.approach_speed = -b2Dot(velocity_b - velocity_a, normal);
+}
 
-    // Ensure we have valid IDs before pushing an event
-    if (body_a_id_ptr && body_b_id_ptr) {
-        m_events.push_back({
-            static_cast<PhysicsManager::BodyId>(body_a_id_ptr),
-            static_cast<PhysicsManager::BodyId>(body_b_id_ptr)
-        });
+void MyContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+{
+    const uint32_t index = find_begin(contact);
+    if (index == NO_EVENT) {
+        return;
+    }
+    CollisionEvent& event = m_events[index];
+    for (int32 i = 0; i < impulse->count; ++i) {
+        event.normal_impulse = b2Max(event.normal_impulse, impulse->normalImpulses[i]);
+        event.tangent_impulse = b2Max(event.tangent_impulse, b2Abs(impulse->tangentImpulses[i]));
     }
 }
 
@@ -36,73 +361,334 @@ PhysicsManager::~PhysicsManager()
     // unique_ptr handles this.
 }
 
-void PhysicsManager::init()
+void PhysicsManager::init(size_t partition_count, size_t event_capacity)
 {
+    if (partition_count == 0) {
+        partition_count = 1;
+    }
+    m_partitions.clear();
+    m_partitions.reserve(partition_count);
     b2Vec2 gravity(0.0f, -9.8f);
-    m_world = std::make_unique<b2World>(gravity);
-    
-    // Create and set the contact listener
-    m_contact_listener = std::make_unique<MyContactListener>(m_collision_events);
-    m_world->SetContactListener(m_contact_listener.get());
+    for (size_t i = 0; i < partition_count; ++i) {
+        auto partition = std::make_unique<Partition>();
+        partition->world = std::make_unique<b2World>(gravity);
+        // Create and set the contact listener
+        partition->contact_listener = std::make_unique<MyContactListener>(event_capacity);
+        partition->world->SetContactListener(partition->contact_listener.get());
+        partition->world->SetContinuousPhysics(m_continuous);
+        m_partitions.push_back(std::move(partition));
+    }
+    m_step_order.assign(partition_count, 0);
+    m_collision_events.reserve(event_capacity);
+    m_reported_event_overflow = false;
+}
+
+void PhysicsManager::step_partition(size_t index)
+{
+    MIYABI_PROFILE_SCOPE("PhysicsPartitionStep");
+    Partition& partition = *m_partitions[index];
+    partition.contact_listener->begin_step();
+    // Events of every sub-step land in the same listener buffer.
+    const StepQuality& quality = m_quality.current();
+    const float dt = m_timeStep / static_cast<float>(quality.sub_steps);
+    for (uint32_t i = 0; i < quality.sub_steps; ++i) {
+        partition.world->Step(dt, quality.velocity_iterations, quality.position_iterations);
+    }
+}
+
+bool PhysicsManager::set_step_config(const PhysicsStepConfig& config)
+{
+    if (!std::isfinite(config.time_step) || config.time_step <= 0.0f || config.velocity_iterations < 1
+        || config.position_iterations < 1 || config.sub_steps < 1 || config.sub_steps > MAX_SUB_STEPS
+        || !std::isfinite(config.budget_ms) || config.budget_ms < 0.0f) {
+        std::cerr << "PhysicsManager::set_step_config - invalid config time_step=" << config.time_step
+                  << " velocity_iterations=" << config.velocity_iterations
+                  << " position_iterations=" << config.position_iterations
+                  << " sub_steps=" << config.sub_steps
+                  << " budget_ms=" << config.budget_ms << std::endl;
+        return false;
+    }
+    m_timeStep = config.time_step;
+    m_velocityIterations = config.velocity_iterations;
+    m_positionIterations = config.position_iterations;
+    m_subSteps = config.sub_steps;
+    m_continuous = config.continuous;
+    m_budgetMs = config.budget_ms;
+    for (const auto& partition : m_partitions) {
+        partition->world->SetContinuousPhysics(m_continuous);
+    }
+    // Start again from full quality.
+    m_quality.configure({m_subSteps, m_velocityIterations, m_positionIterations}, m_budgetMs);
+    return true;
+}
+
+PhysicsStepConfig PhysicsManager::step_config() const
+{
+    PhysicsStepConfig config{};
+    config.time_step = m_timeStep;
+    config.velocity_iterations = m_velocityIterations;
+    config.position_iterations = m_positionIterations;
+    config.sub_steps = m_subSteps;
+    config.continuous = m_continuous;
+    config.budget_ms = m_budgetMs;
+    return config;
 }
 
 void PhysicsManager::step()
 {
-    if (!m_world) {
+    if (m_partitions.empty()) {
         return;
     }
-    // Clear events from the previous step before the new step
-    m_collision_events.clear();
-    m_world->Step(m_timeStep, m_velocityIterations, m_positionIterations);
+    MIYABI_PROFILE_SCOPE("PhysicsWorldStep");
+    const auto start = std::chrono::steady_clock::now();
+    // Write this step's events into the back buffer; the published ones
+    // stay readable until the merge below completes.
+    m_collision_events.begin_write();
+    const size_t count = m_partitions.size();
+    if (m_jobs && count > 1) {
+        m_steps_finished.store(0, std::memory_order_relaxed);
+        m_jobs->parallel_for(count, [this](size_t index, size_t) {
+            step_partition(index);
+            m_step_order[m_steps_finished.fetch_add(1, std::memory_order_relaxed)] = index;
+        }, m_deterministic);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            step_partition(i);
+            m_step_order[i] = i;
+        }
+    }
+    // parallel_for has joined, so every partition's events are visible.
+    size_t dropped = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t index = m_deterministic ? i : m_step_order[i];
+        const MyContactListener& listener = *m_partitions[index]->contact_listener;
+        m_collision_events.append(listener.events().data(), listener.events().size());
+        dropped += listener.dropped();
+    }
+    m_collision_events.publish();
+    dropped += m_collision_events.dropped();
+    if (dropped > 0 && !m_reported_event_overflow) {
+        std::cerr << "PhysicsManager::step - contact event capacity " << m_collision_events.capacity()
+                  << " exceeded, dropped " << dropped << " events" << std::endl;
+        m_reported_event_overflow = true;
+    }
+    refresh_body_states();
+
+    if (m_quality.adaptive()) {
+        m_quality.record_step(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    MIYABI_PROFILE_COUNTER("PhysicsQualityLevel", m_quality.level());
+    MIYABI_PROFILE_COUNTER("PhysicsSubSteps", m_quality.current().sub_steps);
+    MIYABI_PROFILE_COUNTER("PhysicsVelocityIterations", m_quality.current().velocity_iterations);
+    MIYABI_PROFILE_COUNTER("PhysicsPositionIterations", m_quality.current().position_iterations);
+}
+
+PhysicsManager::BodyId PhysicsManager::register_body(b2Body* body)
+{
+    const BodyId id = m_body_ids.insert();
+    m_bodies.push_back(body);
+    body->GetUserData().pointer = static_cast<uintptr_t>(id);
+
+    const b2Vec2& position = body->GetPosition();
+    const b2Vec2& velocity = body->GetLinearVelocity();
+    m_body_states.push_back({
+        id,
+        {position.x, position.y},
+        body->GetAngle(),
+        {velocity.x, velocity.y}
+    });
+    m_body_activity.push_back(BODY_NEW);
+    return id;
+}
+
+void PhysicsManager::refresh_body_states()
+{
+    // One linear pass over the contiguous tables. A body that was asleep
+    // before the step and still is cannot have moved, so only its flag is
+    // read; a body that fell asleep during the step is compared one last
+    // time to publish its resting transform.
+    m_moved_body_states.clear();
+    for (size_t i = 0; i < m_bodies.size(); ++i) {
+        const b2Body* body = m_bodies[i];
+        const bool awake = body->IsAwake();
+        uint8_t& activity = m_body_activity[i];
+        if (activity == BODY_ASLEEP && !awake) {
+            continue;
+        }
+        BodyState& state = m_body_states[i];
+        const b2Vec2& position = body->GetPosition();
+        const b2Vec2& velocity = body->GetLinearVelocity();
+        const float angle = body->GetAngle();
+        const bool moved = activity == BODY_NEW || position.x != state.position.x
+            || position.y != state.position.y || angle != state.angle;
+        state.position = {position.x, position.y};
+        state.angle = angle;
+        state.velocity = {velocity.x, velocity.y};
+        activity = awake ? BODY_AWAKE : BODY_ASLEEP;
+        if (moved) {
+            m_moved_body_states.push_back(state);
+        }
+    }
 }
 
 PhysicsManager::BodyId PhysicsManager::create_dynamic_box(float x, float y, float width, float height)
 {
-    if (!m_world) return 0;
+    return create_body(make_box_desc(BodyKind::Dynamic, x, y, width, height));
+}
 
-    b2BodyDef bodyDef;
-    bodyDef.type = b2_dynamicBody;
-    bodyDef.position.Set(x, y);
-    b2Body* body = m_world->CreateBody(&bodyDef);
+PhysicsManager::BodyId PhysicsManager::create_static_box(float x, float y, float width, float height)
+{
+    return create_body(make_box_desc(BodyKind::Static, x, y, width, height));
+}
+
+PhysicsManager::BodyId PhysicsManager::create_body(const BodyDesc& desc, const Vec2* vertices, size_t vertex_count)
+{
+    if (m_partitions.empty()) return 0;
+    if (desc.partition >= m_partitions.size()) {
+        std::cerr << "PhysicsManager::create_body - invalid partition " << desc.partition
+                  << " (partitions=" << m_partitions.size() << ")" << std::endl;
+        return 0;
+    }
+    // Box2D asserts (or corrupts the broad-phase) on these instead of failing.
+    if (!std::isfinite(desc.density) || desc.density < 0.0f ||
+        !std::isfinite(desc.friction) || desc.friction < 0.0f) {
+        std::cerr << "PhysicsManager::create_body - invalid material density=" << desc.density
+                  << " friction=" << desc.friction << std::endl;
+        return 0;
+    }
+
+    // Build the shape first so an invalid descriptor creates nothing.
+    b2PolygonShape polygon;
+    b2CircleShape circle;
+    const b2Shape* shape = nullptr;
+    switch (desc.shape) {
+        case BodyShapeType::Box:
+            if (!is_positive_finite(desc.half_extents.x) || !is_positive_finite(desc.half_extents.y)) {
+                std::cerr << "PhysicsManager::create_body - invalid box half_extents=(" << desc.half_extents.x
+                          << ", " << desc.half_extents.y << ")" << std::endl;
+                return 0;
+            }
+            polygon.SetAsBox(desc.half_extents.x, desc.half_extents.y);
+            shape = &polygon;
+            break;
+        case BodyShapeType::Circle:
+            if (!is_positive_finite(desc.radius)) {
+                std::cerr << "PhysicsManager::create_body - invalid circle radius=" << desc.radius << std::endl;
+                return 0;
+            }
+            circle.m_radius = desc.radius;
+            shape = &circle;
+            break;
+        case BodyShapeType::Polygon: {
+            const size_t first = desc.vertex_offset;
+            const size_t count = desc.vertex_count;
+            if (count < 3 || count > b2_maxPolygonVertices || first > vertex_count || count > vertex_count - first) {
+                std::cerr << "PhysicsManager::create_body - invalid polygon vertex range offset=" << first
+                          << " count=" << count << " available=" << vertex_count << std::endl;
+                return 0;
+            }
+            b2Vec2 points[b2_maxPolygonVertices];
+            for (size_t i = 0; i < count; ++i) {
+                points[i].Set(vertices[first + i].x, vertices[first + i].y);
+            }
+            if (is_degenerate_polygon(points, count)) {
+                std::cerr << "PhysicsManager::create_body - degenerate polygon count=" << count << std::endl;
+                return 0;
+            }
+            polygon.Set(points, static_cast<int32>(count));
+            shape = &polygon;
+            break;
+        }
+    }
+    if (!shape) {
+        std::cerr << "PhysicsManager::create_body - unknown shape type" << std::endl;
+        return 0;
+    }
 
-    b2PolygonShape dynamicBox;
-    dynamicBox.SetAsBox(width / 2.0f, height / 2.0f);
+    b2BodyDef bodyDef;
+    switch (desc.kind) {
+        case BodyKind::Dynamic: bodyDef.type = b2_dynamicBody; break;
+        case BodyKind::Kinematic: bodyDef.type = b2_kinematicBody; break;
+        default: bodyDef.type = b2_staticBody; break;
+    }
+    bodyDef.position.Set(desc.position.x, desc.position.y);
+    bodyDef.angle = desc.angle;
+    bodyDef.bullet = desc.bullet;
+    b2Body* body = m_partitions[desc.partition]->world->CreateBody(&bodyDef);
 
     b2FixtureDef fixtureDef;
-    fixtureDef.shape = &dynamicBox;
-    fixtureDef.density = 1.0f;
-    fixtureDef.friction = 0.3f;
+    fixtureDef.shape = shape;
+    fixtureDef.density = desc.density;
+    fixtureDef.friction = desc.friction;
+    fixtureDef.restitution = desc.restitution;
+    fixtureDef.filter.categoryBits = desc.category_bits;
+    fixtureDef.filter.maskBits = desc.mask_bits;
+    fixtureDef.filter.groupIndex = desc.group_index;
+    fixtureDef.isSensor = desc.sensor;
     body->CreateFixture(&fixtureDef);
 
-    BodyId id = m_next_body_id++;
-    m_bodies[id] = body;
-    body->GetUserData().pointer = static_cast<uintptr_t>(id);
-    return id;
+    return register_body(body);
 }
 
-PhysicsManager::BodyId PhysicsManager::create_static_box(float x, float y, float width, float height)
+size_t PhysicsManager::create_bodies(const BodyDesc* descs, size_t count, const Vec2* vertices, size_t vertex_count, BodyId* out_ids)
 {
-    if (!m_world) return 0;
+    m_bodies.reserve(m_bodies.size() + count);
+    m_body_states.reserve(m_body_states.size() + count);
+    m_body_activity.reserve(m_body_activity.size() + count);
+    size_t created = 0;
+    for (size_t i = 0; i < count; ++i) {
+        out_ids[i] = create_body(descs[i], vertices, vertex_count);
+        if (out_ids[i] != 0) {
+            ++created;
+        }
+    }
+    return created;
+}
 
-    b2BodyDef groundBodyDef;
-    groundBodyDef.position.Set(x, y);
-    b2Body* groundBody = m_world->CreateBody(&groundBodyDef);
+size_t PhysicsManager::destroy_bodies(const BodyId* ids, size_t count)
+{
+    size_t destroyed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (destroy_body(ids[i])) {
+            ++destroyed;
+        }
+    }
+    return destroyed;
+}
 
-    b2PolygonShape groundBox;
-    groundBox.SetAsBox(width / 2.0f, height / 2.0f);
-    groundBody->CreateFixture(&groundBox, 0.0f);
+bool PhysicsManager::destroy_body(BodyId id)
+{
+    size_t index = 0;
+    if (!m_body_ids.remove(id, index)) {
+        return false;
+    }
+    b2Body* body = m_bodies[index];
+    body->GetWorld()->DestroyBody(body);
+    // Mirror the slot map's swap-remove.
+    m_bodies[index] = m_bodies.back();
+    m_bodies.pop_back();
+    m_body_states[index] = m_body_states.back();
+    m_body_states.pop_back();
+    m_body_activity[index] = m_body_activity.back();
+    m_body_activity.pop_back();
+    return true;
+}
 
-    BodyId id = m_next_body_id++;
-    m_bodies[id] = groundBody;
-    groundBody->GetUserData().pointer = static_cast<uintptr_t>(id);
-    return id;
+bool PhysicsManager::set_bullet(BodyId id, bool bullet)
+{
+    const size_t index = m_body_ids.dense_index(id);
+    if (index == BodySlotMap::NPOS) {
+        return false;
+    }
+    m_bodies[index]->SetBullet(bullet);
+    return true;
 }
 
 Vec2 PhysicsManager::get_body_position(BodyId id)
 {
-    auto it = m_bodies.find(id);
-    if (it != m_bodies.end()) {
-        b2Vec2 position = it->second->GetPosition();
+    const size_t index = m_body_ids.dense_index(id);
+    if (index != BodySlotMap::NPOS) {
+        b2Vec2 position = m_bodies[index]->GetPosition();
         return {position.x, position.y};
     }
     // Return a default/error value
@@ -111,7 +697,677 @@ Vec2 PhysicsManager::get_body_position(BodyId id)
 
 const std::vector<CollisionEvent>& PhysicsManager::get_collision_events() const
 {
-    return m_collision_events;
+    return m_collision_events.published();
+}
+
+const std::vector<BodyState>& PhysicsManager::get_body_states() const
+{
+    return m_body_states;
+}
+
+size_t PhysicsManager::fill_body_states(const BodyId* ids, size_t count, BodyState* out) const
+{
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t index = m_body_ids.dense_index(ids[i]);
+        if (index != BodySlotMap::NPOS) {
+            out[i] = m_body_states[index];
+            ++found;
+        } else {
+            out[i] = BodyState{0, {0.0f, 0.0f}, 0.0f, {0.0f, 0.0f}};
+        }
+    }
+    return found;
+}
+
+size_t PhysicsManager::raycast(const RayCastQuery* queries, size_t count, QueryHit* out) const
+{
+    auto run = [this, queries, out](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const RayCastQuery& query = queries[i];
+            out[i] = QueryHit{};
+            // b2DynamicTree::RayCast asserts on zero-length rays.
+            if (query.translation.x == 0.0f && query.translation.y == 0.0f) {
+                continue;
+            }
+            const b2Vec2 from(query.origin.x, query.origin.y);
+            const b2Vec2 to(query.origin.x + query.translation.x, query.origin.y + query.translation.y);
+            ClosestRayCallback callback(query.mask_bits);
+            for (const auto& partition : m_partitions) {
+                partition->world->RayCast(&callback, from, to);
+            }
+            if (callback.hit()) {
+                out[i] = callback.result();
+            }
+        }
+    };
+    run_query_batches(count, run);
+
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (out[i].body != 0) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+size_t PhysicsManager::shape_cast(const ShapeCastQuery* queries, size_t count, QueryHit* out) const
+{
+    auto run = [this, queries, out](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const ShapeCastQuery& query = queries[i];
+            out[i] = QueryHit{};
+            b2PolygonShape polygon;
+            b2CircleShape circle;
+            const b2Shape* shape = nullptr;
+            if (query.shape == BodyShapeType::Box) {
+                polygon.SetAsBox(query.half_extents.x, query.half_extents.y);
+                shape = &polygon;
+            } else if (query.shape == BodyShapeType::Circle) {
+                circle.m_radius = query.radius;
+                shape = &circle;
+            } else {
+                continue;
+            }
+
+            const b2Transform start(b2Vec2(query.position.x, query.position.y), b2Rot(query.angle));
+            const b2Vec2 translation(query.translation.x, query.translation.y);
+            const b2Transform end_transform(start.p + translation, start.q);
+            b2AABB swept;
+            b2AABB end_aabb;
+            shape->ComputeAABB(&swept, start, 0);
+            shape->ComputeAABB(&end_aabb, end_transform, 0);
+            swept.Combine(end_aabb);
+
+            ClosestShapeCastCallback callback(*shape, start, translation, query.mask_bits);
+            for (const auto& partition : m_partitions) {
+                partition->world->QueryAABB(&callback, swept);
+            }
+            if (callback.hit()) {
+                out[i] = callback.result();
+            }
+        }
+    };
+    run_query_batches(count, run);
+
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (out[i].body != 0) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+size_t PhysicsManager::query_aabb(const AabbQuery* queries, size_t count, BodyId* out_ids, size_t id_capacity, QueryRange* out_ranges) const
+{
+    // Serial: each query's ids start where the previous query's ended.
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const AabbQuery& query = queries[i];
+        b2AABB aabb;
+        aabb.lowerBound.Set(query.lower.x, query.lower.y);
+        aabb.upperBound.Set(query.upper.x, query.upper.y);
+        AabbOverlapCallback callback(aabb, query.mask_bits, out_ids + written, id_capacity - written);
+        for (const auto& partition : m_partitions) {
+            partition->world->QueryAABB(&callback, aabb);
+        }
+        out_ranges[i] = QueryRange{
+            static_cast<uint32_t>(written),
+            static_cast<uint32_t>(callback.written()),
+            static_cast<uint32_t>(callback.found())
+        };
+        written += callback.written();
+    }
+    return written;
+}
+
+void PhysicsManager::run_query_batches(size_t count, const std::function<void(size_t, size_t)>& run) const
+{
+    // World queries only read the broadphase, so chunks can run
+    // concurrently as long as no step is in progress.
+    if (!m_jobs || count < PARALLEL_QUERY_MIN) {
+        run(0, count);
+        return;
+    }
+    const size_t chunks = (count + QUERY_CHUNK - 1) / QUERY_CHUNK;
+    m_jobs->parallel_for(chunks, [count, &run](size_t chunk, size_t) {
+        const size_t begin = chunk * QUERY_CHUNK;
+        run(begin, begin + QUERY_CHUNK < count ? begin + QUERY_CHUNK : count);
+    });
+}
+
+namespace {
+constexpr uint32_t SNAPSHOT_MAGIC = 0x3153504Du; // "MPS1"
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+// Sanity bound so a corrupt header cannot create millions of worlds.
+constexpr uint32_t MAX_SNAPSHOT_PARTITIONS = 1024;
+
+enum SnapshotBodyFlags : uint8_t {
+    SNAPSHOT_AWAKE = 1 << 0,
+    SNAPSHOT_ALLOW_SLEEP = 1 << 1,
+    SNAPSHOT_FIXED_ROTATION = 1 << 2,
+    SNAPSHOT_BULLET = 1 << 3,
+    SNAPSHOT_ENABLED = 1 << 4,
+};
+
+template <typename T>
+void write_value(std::vector<uint8_t>& out, const T& value)
+{
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+void write_vec2(std::vector<uint8_t>& out, const b2Vec2& value)
+{
+    write_value(out, value.x);
+    write_value(out, value.y);
+}
+
+// Bounds-checked reads; after the first short read every read returns a
+// zero value and ok() stays false.
+class SnapshotReader
+{
+public:
+    SnapshotReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    T read()
+    {
+        T value{};
+        if (!m_ok || m_size - m_offset < sizeof(T)) {
+            m_ok = false;
+            return value;
+        }
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    b2Vec2 read_vec2()
+    {
+        const float x = read<float>();
+        const float y = read<float>();
+        return b2Vec2(x, y);
+    }
+
+    // Rejects counts that could not fit in the remaining bytes, so a corrupt
+    // header cannot trigger a huge allocation.
+    uint32_t read_count(size_t min_item_size)
+    {
+        const uint32_t count = read<uint32_t>();
+        if (m_ok && static_cast<uint64_t>(count) * min_item_size > m_size - m_offset) {
+            m_ok = false;
+            return 0;
+        }
+        return count;
+    }
+
+    void fail() { m_ok = false; }
+    bool ok() const { return m_ok; }
+    bool at_end() const { return m_offset == m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+    bool m_ok = true;
+};
+
+struct FixtureRecord {
+    uint8_t shape_type;
+    bool sensor;
+    b2Filter filter;
+    float density;
+    float friction;
+    float restitution;
+    float restitution_threshold;
+    float radius;
+    b2Vec2 center;          // circle
+    int32 count;            // polygon
+    b2Vec2 centroid;
+    b2Vec2 vertices[b2_maxPolygonVertices];
+    b2Vec2 normals[b2_maxPolygonVertices];
+};
+
+struct BodyRecord {
+    PhysicsManager::BodyId id;
+    uint32_t partition;
+    b2BodyDef def;
+    bool awake;
+    uint32_t first_fixture;
+    uint32_t fixture_count;
+};
+
+struct ContactRecord {
+    PhysicsManager::BodyId body_a;
+    uint32_t fixture_a;
+    int32 child_a;
+    PhysicsManager::BodyId body_b;
+    uint32_t fixture_b;
+    int32 child_b;
+    int32 point_count;
+    uint32_t keys[b2_maxManifoldPoints];
+    float normal_impulses[b2_maxManifoldPoints];
+    float tangent_impulses[b2_maxManifoldPoints];
+};
+
+// Index of `fixture` in its body's creation order (the list is newest first).
+uint32_t fixture_creation_index(const b2Fixture* fixture)
+{
+    uint32_t newer = 0;
+    uint32_t total = 0;
+    bool found = false;
+    for (const b2Fixture* f = fixture->GetBody()->GetFixtureList(); f; f = f->GetNext()) {
+        if (f == fixture) {
+            found = true;
+        } else if (!found) {
+            ++newer;
+        }
+        ++total;
+    }
+    return total - 1 - newer;
+}
+} // namespace
+
+void PhysicsManager::save_snapshot(std::vector<uint8_t>& out) const
+{
+    out.clear();
+    if (m_partitions.empty()) {
+        return;
+    }
+    // Rough upper bound for box bodies, to avoid regrowth while writing.
+    out.reserve(64 + m_body_ids.slot_count() * 4 + m_bodies.size() * 200);
+
+    write_value(out, SNAPSHOT_MAGIC);
+    write_value(out, SNAPSHOT_VERSION);
+    write_value(out, static_cast<uint32_t>(m_partitions.size()));
+    write_vec2(out, m_partitions[0]->world->GetGravity());
+
+    write_value(out, static_cast<uint32_t>(m_body_ids.slot_count()));
+    for (size_t slot = 0; slot < m_body_ids.slot_count(); ++slot) {
+        write_value(out, m_body_ids.generation_at(slot));
+    }
+    write_value(out, static_cast<uint32_t>(m_body_ids.free_slots().size()));
+    for (uint32_t slot : m_body_ids.free_slots()) {
+        write_value(out, slot);
+    }
+    write_value(out, static_cast<uint32_t>(m_body_ids.size()));
+    for (size_t i = 0; i < m_body_ids.size(); ++i) {
+        write_value(out, m_body_ids.id_at(i));
+    }
+
+    // Bodies in creation order per partition, so the restored world lists
+    // (and with them island and solver order) match.
+    write_value(out, static_cast<uint32_t>(m_bodies.size()));
+    for (size_t p = 0; p < m_partitions.size(); ++p) {
+        m_snapshot_bodies.clear();
+        for (const b2Body* body = m_partitions[p]->world->GetBodyList(); body; body = body->GetNext()) {
+            m_snapshot_bodies.push_back(body);
+        }
+        for (auto it = m_snapshot_bodies.rbegin(); it != m_snapshot_bodies.rend(); ++it) {
+            const b2Body* body = *it;
+            uint8_t flags = 0;
+            if (body->IsAwake()) flags |= SNAPSHOT_AWAKE;
+            if (body->IsSleepingAllowed()) flags |= SNAPSHOT_ALLOW_SLEEP;
+            if (body->IsFixedRotation()) flags |= SNAPSHOT_FIXED_ROTATION;
+            if (body->IsBullet()) flags |= SNAPSHOT_BULLET;
+            if (body->IsEnabled()) flags |= SNAPSHOT_ENABLED;
+
+            write_value(out, static_cast<uint64_t>(body->GetUserData().pointer));
+            write_value(out, static_cast<uint32_t>(p));
+            write_value(out, static_cast<uint8_t>(body->GetType()));
+            write_value(out, flags);
+            write_vec2(out, body->GetPosition());
+            write_value(out, body->GetAngle());
+            write_vec2(out, body->GetLinearVelocity());
+            write_value(out, body->GetAngularVelocity());
+            write_value(out, body->GetLinearDamping());
+            write_value(out, body->GetAngularDamping());
+            write_value(out, body->GetGravityScale());
+
+            uint32_t fixture_count = 0;
+            for (const b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+                ++fixture_count;
+            }
+            write_value(out, fixture_count);
+            // Fixture lists are newest first too; write oldest first.
+            for (uint32_t index = fixture_count; index-- > 0;) {
+                const b2Fixture* fixture = body->GetFixtureList();
+                for (uint32_t skip = 0; skip < index; ++skip) {
+                    fixture = fixture->GetNext();
+                }
+                const b2Shape* shape = fixture->GetShape();
+                const b2Filter& filter = fixture->GetFilterData();
+                write_value(out, static_cast<uint8_t>(shape->GetType()));
+                write_value(out, static_cast<uint8_t>(fixture->IsSensor() ? 1 : 0));
+                write_value(out, filter.categoryBits);
+                write_value(out, filter.maskBits);
+                write_value(out, filter.groupIndex);
+                write_value(out, fixture->GetDensity());
+                write_value(out, fixture->GetFriction());
+                write_value(out, fixture->GetRestitution());
+                write_value(out, fixture->GetRestitutionThreshold());
+                write_value(out, shape->m_radius);
+                if (shape->GetType() == b2Shape::e_circle) {
+                    write_vec2(out, static_cast<const b2CircleShape*>(shape)->m_p);
+                } else {
+                    // Only circles and polygons are ever created.
+                    const b2PolygonShape* polygon = static_cast<const b2PolygonShape*>(shape);
+                    write_value(out, static_cast<uint32_t>(polygon->m_count));
+                    write_vec2(out, polygon->m_centroid);
+                    for (int32 i = 0; i < polygon->m_count; ++i) {
+                        write_vec2(out, polygon->m_vertices[i]);
+                    }
+                    for (int32 i = 0; i < polygon->m_count; ++i) {
+                        write_vec2(out, polygon->m_normals[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Accumulated impulses of touching contacts; restored so the first step
+    // after a restore warm-starts like the original did.
+    const size_t contact_count_offset = out.size();
+    uint32_t contact_count = 0;
+    write_value(out, contact_count);
+    for (const auto& partition : m_partitions) {
+        for (b2Contact* contact = partition->world->GetContactList(); contact; contact = contact->GetNext()) {
+            const b2Manifold* manifold = contact->GetManifold();
+            if (!contact->IsTouching() || manifold->pointCount == 0) {
+                continue;
+            }
+            const b2Fixture* fixture_a = contact->GetFixtureA();
+            const b2Fixture* fixture_b = contact->GetFixtureB();
+            write_value(out, static_cast<uint64_t>(fixture_a->GetBody()->GetUserData().pointer));
+            write_value(out, fixture_creation_index(fixture_a));
+            write_value(out, contact->GetChildIndexA());
+            write_value(out, static_cast<uint64_t>(fixture_b->GetBody()->GetUserData().pointer));
+            write_value(out, fixture_creation_index(fixture_b));
+            write_value(out, contact->GetChildIndexB());
+            write_value(out, static_cast<uint32_t>(manifold->pointCount));
+            for (int32 i = 0; i < manifold->pointCount; ++i) {
+                write_value(out, manifold->points[i].id.key);
+                write_value(out, manifold->points[i].normalImpulse);
+                write_value(out, manifold->points[i].tangentImpulse);
+            }
+            ++contact_count;
+        }
+    }
+    std::memcpy(out.data() + contact_count_offset, &contact_count, sizeof(contact_count));
+}
+
+bool PhysicsManager::restore_snapshot(const uint8_t* data, size_t size)
+{
+    // Parse and validate everything before touching the live world.
+    SnapshotReader reader(data, size);
+    if (reader.read<uint32_t>() != SNAPSHOT_MAGIC || reader.read<uint32_t>() != SNAPSHOT_VERSION) {
+        std::cerr << "PhysicsManager::restore_snapshot - not a version " << SNAPSHOT_VERSION << " snapshot" << std::endl;
+        return false;
+    }
+    const uint32_t partition_count = reader.read<uint32_t>();
+    if (partition_count == 0 || partition_count > MAX_SNAPSHOT_PARTITIONS) {
+        reader.fail();
+    }
+    const b2Vec2 gravity = reader.read_vec2();
+
+    std::vector<uint32_t> generations(reader.read_count(sizeof(uint32_t)));
+    for (uint32_t& generation : generations) {
+        generation = reader.read<uint32_t>();
+    }
+    std::vector<uint32_t> free_slots(reader.read_count(sizeof(uint32_t)));
+    for (uint32_t& slot : free_slots) {
+        slot = reader.read<uint32_t>();
+    }
+    std::vector<uint64_t> dense_ids(reader.read_count(sizeof(uint64_t)));
+    for (uint64_t& id : dense_ids) {
+        id = reader.read<uint64_t>();
+    }
+
+    constexpr size_t MIN_BODY_BYTES = 8 + 4 + 2 + 4 * 9 + 4;
+    constexpr size_t MIN_FIXTURE_BYTES = 2 + 6 + 4 * 5 + 8;
+    std::vector<BodyRecord> bodies(reader.read_count(MIN_BODY_BYTES));
+    std::vector<FixtureRecord> fixtures;
+    for (BodyRecord& body : bodies) {
+        body.id = reader.read<uint64_t>();
+        body.partition = reader.read<uint32_t>();
+        const uint8_t type = reader.read<uint8_t>();
+        const uint8_t flags = reader.read<uint8_t>();
+        body.def.type = static_cast<b2BodyType>(type);
+        body.def.position = reader.read_vec2();
+        body.def.angle = reader.read<float>();
+        body.def.linearVelocity = reader.read_vec2();
+        body.def.angularVelocity = reader.read<float>();
+        body.def.linearDamping = reader.read<float>();
+        body.def.angularDamping = reader.read<float>();
+        body.def.gravityScale = reader.read<float>();
+        body.def.allowSleep = (flags & SNAPSHOT_ALLOW_SLEEP) != 0;
+        body.def.fixedRotation = (flags & SNAPSHOT_FIXED_ROTATION) != 0;
+        body.def.bullet = (flags & SNAPSHOT_BULLET) != 0;
+        body.def.enabled = (flags & SNAPSHOT_ENABLED) != 0;
+        // Everything starts awake so the contact pass below sees every
+        // pair; sleeping bodies are put back to sleep afterwards.
+        body.def.awake = true;
+        body.awake = (flags & SNAPSHOT_AWAKE) != 0;
+        if (type > b2_dynamicBody || body.partition >= partition_count) {
+            reader.fail();
+            break;
+        }
+
+        body.first_fixture = static_cast<uint32_t>(fixtures.size());
+        body.fixture_count = reader.read_count(MIN_FIXTURE_BYTES);
+        for (uint32_t f = 0; f < body.fixture_count && reader.ok(); ++f) {
+            FixtureRecord fixture{};
+            fixture.shape_type = reader.read<uint8_t>();
+            fixture.sensor = reader.read<uint8_t>() != 0;
+            fixture.filter.categoryBits = reader.read<uint16>();
+            fixture.filter.maskBits = reader.read<uint16>();
+            fixture.filter.groupIndex = reader.read<int16_t>();
+            fixture.density = reader.read<float>();
+            fixture.friction = reader.read<float>();
+            fixture.restitution = reader.read<float>();
+            fixture.restitution_threshold = reader.read<float>();
+            fixture.radius = reader.read<float>();
+            if (fixture.shape_type == b2Shape::e_circle) {
+                fixture.center = reader.read_vec2();
+            } else if (fixture.shape_type == b2Shape::e_polygon) {
+                const uint32_t count = reader.read<uint32_t>();
+                if (count < 3 || count > b2_maxPolygonVertices) {
+                    reader.fail();
+                    break;
+                }
+                fixture.count = static_cast<int32>(count);
+                fixture.centroid = reader.read_vec2();
+                for (uint32_t i = 0; i < count; ++i) {
+                    fixture.vertices[i] = reader.read_vec2();
+                }
+                for (uint32_t i = 0; i < count; ++i) {
+                    fixture.normals[i] = reader.read_vec2();
+                }
+            } else {
+                reader.fail();
+                break;
+            }
+            fixtures.push_back(fixture);
+        }
+        if (!reader.ok()) {
+            break;
+        }
+    }
+
+    constexpr size_t MIN_CONTACT_BYTES = 2 * (8 + 4 + 4) + 4;
+    std::vector<ContactRecord> contacts(reader.ok() ? reader.read_count(MIN_CONTACT_BYTES) : 0);
+    for (ContactRecord& contact : contacts) {
+        contact.body_a = reader.read<uint64_t>();
+        contact.fixture_a = reader.read<uint32_t>();
+        contact.child_a = reader.read<int32>();
+        contact.body_b = reader.read<uint64_t>();
+        contact.fixture_b = reader.read<uint32_t>();
+        contact.child_b = reader.read<int32>();
+        const uint32_t points = reader.read<uint32_t>();
+        if (points > b2_maxManifoldPoints) {
+            reader.fail();
+            break;
+        }
+        contact.point_count = static_cast<int32>(points);
+        for (int32 i = 0; i < contact.point_count; ++i) {
+            contact.keys[i] = reader.read<uint32_t>();
+            contact.normal_impulses[i] = reader.read<float>();
+            contact.tangent_impulses[i] = reader.read<float>();
+        }
+    }
+
+    BodySlotMap body_ids;
+    if (!reader.ok() || !reader.at_end() || bodies.size() != dense_ids.size()
+        || !body_ids.restore(generations, free_slots, dense_ids)) {
+        std::cerr << "PhysicsManager::restore_snapshot - malformed snapshot (" << size << " bytes)" << std::endl;
+        return false;
+    }
+    std::vector<bool> seen(bodies.size(), false);
+    for (const BodyRecord& body : bodies) {
+        const size_t index = body_ids.dense_index(body.id);
+        if (index == BodySlotMap::NPOS || seen[index]) {
+            std::cerr << "PhysicsManager::restore_snapshot - body id " << body.id << " does not match the id map" << std::endl;
+            return false;
+        }
+        seen[index] = true;
+    }
+
+    // Rebuild. Existing worlds (and every body in them) are destroyed.
+    init(partition_count, m_collision_events.capacity());
+    for (const auto& partition : m_partitions) {
+        partition->world->SetGravity(gravity);
+    }
+    m_body_ids = std::move(body_ids);
+    m_bodies.assign(bodies.size(), nullptr);
+    m_body_states.assign(bodies.size(), BodyState{0, {0.0f, 0.0f}, 0.0f, {0.0f, 0.0f}});
+    // Every restored body is published by the refresh below.
+    m_body_activity.assign(bodies.size(), BODY_NEW);
+    std::vector<b2Fixture*> created_fixtures(fixtures.size(), nullptr);
+    for (const BodyRecord& record : bodies) {
+        b2Body* body = m_partitions[record.partition]->world->CreateBody(&record.def);
+        for (uint32_t f = 0; f < record.fixture_count; ++f) {
+            const FixtureRecord& saved = fixtures[record.first_fixture + f];
+            b2PolygonShape polygon;
+            b2CircleShape circle;
+            b2Shape* shape = nullptr;
+            if (saved.shape_type == b2Shape::e_circle) {
+                circle.m_p = saved.center;
+                shape = &circle;
+            } else {
+                // Copied verbatim rather than through Set(), which would
+                // recompute the hull.
+                polygon.m_count = saved.count;
+                polygon.m_centroid = saved.centroid;
+                for (int32 i = 0; i < saved.count; ++i) {
+                    polygon.m_vertices[i] = saved.vertices[i];
+                    polygon.m_normals[i] = saved.normals[i];
+                }
+                shape = &polygon;
+            }
+            shape->m_radius = saved.radius;
+
+            b2FixtureDef fixture_def;
+            fixture_def.shape = shape;
+            fixture_def.density = saved.density;
+            fixture_def.friction = saved.friction;
+            fixture_def.restitution = saved.restitution;
+            fixture_def.restitutionThreshold = saved.restitution_threshold;
+            fixture_def.filter = saved.filter;
+            fixture_def.isSensor = saved.sensor;
+            created_fixtures[record.first_fixture + f] = body->CreateFixture(&fixture_def);
+        }
+        body->GetUserData().pointer = static_cast<uintptr_t>(record.id);
+        const size_t index = m_body_ids.dense_index(record.id);
+        m_bodies[index] = body;
+        m_body_states[index].id = record.id;
+    }
+
+    // b2World scales warm-start impulses by the ratio of this step's dt to
+    // the previous one, which a fresh world does not have (its first step
+    // would zero the saved impulses). One real sub-step primes it; then
+    // every body is put back exactly as saved. The events these steps
+    // report are dropped below.
+    const StepQuality& quality = m_quality.current();
+    const float sub_step = m_timeStep / static_cast<float>(quality.sub_steps);
+    for (const auto& partition : m_partitions) {
+        partition->contact_listener->begin_step();
+        partition->world->Step(sub_step, quality.velocity_iterations, quality.position_iterations);
+    }
+    for (const BodyRecord& record : bodies) {
+        b2Body* body = m_bodies[m_body_ids.dense_index(record.id)];
+        body->SetTransform(record.def.position, record.def.angle);
+        body->SetLinearVelocity(record.def.linearVelocity);
+        body->SetAngularVelocity(record.def.angularVelocity);
+        // Also restarts the sleep timer the priming step advanced.
+        body->SetAwake(true);
+    }
+
+    // A zero-length step rebuilds the contacts and their manifolds at the
+    // saved poses without moving anything; then the saved impulses are
+    // written back and everything else starts cold.
+    for (const auto& partition : m_partitions) {
+        partition->world->Step(0.0f, quality.velocity_iterations, quality.position_iterations);
+    }
+    std::map<std::tuple<const b2Fixture*, int32, const b2Fixture*, int32>, const ContactRecord*> saved_contacts;
+    std::vector<uint32_t> first_fixture_by_index(bodies.size(), 0);
+    std::vector<uint32_t> fixture_count_by_index(bodies.size(), 0);
+    for (const BodyRecord& record : bodies) {
+        const size_t index = m_body_ids.dense_index(record.id);
+        first_fixture_by_index[index] = record.first_fixture;
+        fixture_count_by_index[index] = record.fixture_count;
+    }
+    auto resolve_fixture = [&](PhysicsManager::BodyId id, uint32_t fixture) -> const b2Fixture* {
+        const size_t index = m_body_ids.dense_index(id);
+        if (index == BodySlotMap::NPOS || fixture >= fixture_count_by_index[index]) {
+            return nullptr;
+        }
+        return created_fixtures[first_fixture_by_index[index] + fixture];
+    };
+    for (const ContactRecord& contact : contacts) {
+        const b2Fixture* fixture_a = resolve_fixture(contact.body_a, contact.fixture_a);
+        const b2Fixture* fixture_b = resolve_fixture(contact.body_b, contact.fixture_b);
+        if (fixture_a && fixture_b) {
+            saved_contacts[std::make_tuple(fixture_a, contact.child_a, fixture_b, contact.child_b)] = &contact;
+        }
+    }
+    for (const auto& partition : m_partitions) {
+        for (b2Contact* contact = partition->world->GetContactList(); contact; contact = contact->GetNext()) {
+            const auto found = saved_contacts.find(std::make_tuple(
+                static_cast<const b2Fixture*>(contact->GetFixtureA()), contact->GetChildIndexA(),
+                static_cast<const b2Fixture*>(contact->GetFixtureB()), contact->GetChildIndexB()));
+            const ContactRecord* saved = found != saved_contacts.end() ? found->second : nullptr;
+            // Points are matched by feature id, like b2Contact::Update
+            // matches them between steps. Unmatched points still hold
+            // impulses carried over from the priming step.
+            b2Manifold* manifold = contact->GetManifold();
+            for (int32 i = 0; i < manifold->pointCount; ++i) {
+                manifold->points[i].normalImpulse = 0.0f;
+                manifold->points[i].tangentImpulse = 0.0f;
+                for (int32 j = 0; saved && j < saved->point_count; ++j) {
+                    if (manifold->points[i].id.key == saved->keys[j]) {
+                        manifold->points[i].normalImpulse = saved->normal_impulses[j];
+                        manifold->points[i].tangentImpulse = saved->tangent_impulses[j];
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    for (const BodyRecord& record : bodies) {
+        if (!record.awake) {
+            m_bodies[m_body_ids.dense_index(record.id)]->SetAwake(false);
+        }
+    }
+
+    // Events from before the restore (and from the contact pass) are stale.
+    m_collision_events.begin_write();
+    m_collision_events.publish();
+    refresh_body_states();
+    return true;
 }
 
 }
@@ -1,26 +1,64 @@
 #pragma once
 
-#include "miyabi/bridge.h" // For Vec2 and CollisionEvent forward declaration
+#include "miyabi/bridge.h" // For Vec2, CollisionEvent and BodyState forward declarations
+#include "physics/AdaptiveStepQuality.hpp"
+#include "physics/BodySlotMap.hpp"
+#include "physics/EventArena.hpp"
 #include <box2d/box2d.h>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
-#include <unordered_map>
+#include <cstddef>
 #include <cstdint>
 
 // Forward declare to avoid including box2d headers in other files
 class b2Contact;
 
 namespace miyabi {
+namespace jobs {
+class JobSystem;
+}
 namespace physics {
 
+// Records one partition's contact events for the step in progress into a
+// buffer allocated up front (events past the capacity are dropped and
+// counted). Begin events get their approach speed in PreSolve and the
+// largest impulses of the step in PostSolve.
 class MyContactListener : public b2ContactListener
 {
 public:
-    MyContactListener(std::vector<CollisionEvent>& events);
+    explicit MyContactListener(size_t capacity);
+
+    // Clears the previous step's events.
+    void begin_step();
+    const std::vector<CollisionEvent>& events() const { return m_events; }
+    size_t dropped() const { return m_dropped; }
+
     void BeginContact(b2Contact* contact) override;
+    void EndContact(b2Contact* contact) override;
+    void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override;
+    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
 
 private:
-    std::vector<CollisionEvent>& m_events;
+    // Open-addressing map from a contact to its begin event in this step;
+    // stale entries are recognised by their stamp, so clearing is O(1).
+    struct BeginSlot {
+        const b2Contact* contact;
+        uint32_t event;
+        uint32_t stamp;
+    };
+
+    bool push(const CollisionEvent& event);
+    void remember_begin(const b2Contact* contact, uint32_t event);
+    uint32_t find_begin(const b2Contact* contact) const;
+
+    std::vector<CollisionEvent> m_events;
+    size_t m_capacity;
+    size_t m_dropped;
+    std::vector<BeginSlot> m_begin_slots; // power of two, >= 2 * capacity
+    uint32_t m_stamp;
+    size_t m_begin_count;
 };
 
 class PhysicsManager
@@ -31,25 +69,151 @@ public:
     PhysicsManager();
     ~PhysicsManager();
 
-    void init();
+    static constexpr size_t DEFAULT_EVENT_CAPACITY = 8192;
+
+    // Creates `partition_count` independent worlds. A body lives in the
+    // partition named by its descriptor and only collides with bodies in
+    // the same partition; partitions are stepped concurrently when a job
+    // system is set. Each step reports at most `event_capacity` contact
+    // events.
+    void init(size_t partition_count = 1, size_t event_capacity = DEFAULT_EVENT_CAPACITY);
     void step();
 
+    // Steps partitions on `jobs` (nullptr: serially on the caller). The job
+    // system must outlive this manager or be unset first.
+    void set_job_system(jobs::JobSystem* jobs) { m_jobs = jobs; }
+    // Deterministic mode pins each partition to the same worker every step
+    // and merges collision events in partition order. Otherwise partitions
+    // are handed out dynamically and events are merged in completion
+    // order. Body states are identical either way.
+    void set_deterministic(bool deterministic) { m_deterministic = deterministic; }
+    size_t partition_count() const { return m_partitions.size(); }
+
+    // Simulated time per step(), solver iterations, sub-steps per step,
+    // continuous collision (needed for bullet bodies) and the adaptive
+    // budget. Returns false, keeping the current settings, when a value is
+    // out of range.
+    bool set_step_config(const PhysicsStepConfig& config);
+    PhysicsStepConfig step_config() const;
+    // With a budget, every step that takes longer than budget_ms drops one
+    // notch of quality (sub-steps first, then velocity iterations, then
+    // position iterations, never below one each) and a run of steps well
+    // under budget restores one. The level and the iterations in use are
+    // reported as profiler counters. Timing-driven, so not deterministic.
+    uint32_t quality_level() const { return m_quality.level(); }
+    // Continuous collision against other dynamic bodies for fast movers.
+    // Returns false for unknown or destroyed ids.
+    bool set_bullet(BodyId id, bool bullet);
+
     BodyId create_dynamic_box(float x, float y, float width, float height);
     BodyId create_static_box(float x, float y, float width, float height);
+    // Polygon descriptors read `desc.vertex_count` points starting at
+    // `desc.vertex_offset` in `vertices`. Returns 0 for invalid descriptors.
+    BodyId create_body(const BodyDesc& desc, const Vec2* vertices = nullptr, size_t vertex_count = 0);
+    // Creates one body per descriptor and writes its id (0 on failure) to
+    // the same index of `out_ids`. Returns the number of bodies created.
+    size_t create_bodies(const BodyDesc* descs, size_t count, const Vec2* vertices, size_t vertex_count, BodyId* out_ids);
+    // Destroys the body; its id (and any copy of it) stops resolving.
+    // Returns false for unknown or already destroyed ids.
+    bool destroy_body(BodyId id);
+    // Returns the number of bodies destroyed.
+    size_t destroy_bodies(const BodyId* ids, size_t count);
+    size_t body_count() const { return m_body_ids.size(); }
     Vec2 get_body_position(BodyId id);
+    // Contact events of the last step, in the arena's published buffer: the
+    // reference and its data stay valid until the end of the next step.
+    // Begin/End events for bodies destroyed between steps are not reported.
     const std::vector<CollisionEvent>& get_collision_events() const;
+    // Events lost to a full arena in the last step.
+    size_t dropped_collision_events() const { return m_collision_events.dropped(); }
+
+    // State of every live body as of the last step (or creation), in no
+    // particular order.
+    const std::vector<BodyState>& get_body_states() const;
+    // Copies the states of `ids` into `out` (same order, up to `count`
+    // entries). Unknown or destroyed ids produce a state with id 0. Returns
+    // the number of ids that were found.
+    size_t fill_body_states(const BodyId* ids, size_t count, BodyState* out) const;
+    // States of the bodies whose position or angle changed in the last step
+    // (plus bodies created or restored since the step before), in no
+    // particular order. Bodies that stayed asleep are not even compared, so
+    // a settled scene publishes an empty list. Valid until the next step;
+    // may name bodies destroyed since.
+    const std::vector<BodyState>& get_moved_body_states() const { return m_moved_body_states; }
 
+    // Spatial queries against the broadphase of every partition. Call
+    // between steps. Ray and shape casts write the closest hit of query i to
+    // out[i] (body 0 on a miss) and run on the job system for large
+    // batches; they return the number of hits.
+    size_t raycast(const RayCastQuery* queries, size_t count, QueryHit* out) const;
+    // Box and circle shapes only; other shapes never hit.
+    size_t shape_cast(const ShapeCastQuery* queries, size_t count, QueryHit* out) const;
+    // Ids of the bodies whose fixture AABBs overlap each query, packed into
+    // `out_ids` in query order; out_ranges[i] says where query i's ids are
+    // and how many overlaps it found in total (including ones that did not
+    // fit). Returns the number of ids written.
+    size_t query_aabb(const AabbQuery* queries, size_t count, BodyId* out_ids, size_t id_capacity, QueryRange* out_ranges) const;
+
+    // Compact binary snapshot (native endianness) of every partition:
+    // bodies, fixtures, velocities, sleep state, the body id map and the
+    // impulses of touching contacts for warm starting. Overwrites `out`;
+    // empty before init().
+    void save_snapshot(std::vector<uint8_t>& out) const;
+    // Rebuilds all partitions from save_snapshot() output; saved ids resolve
+    // to the restored bodies. Restoring the same snapshot always continues
+    // the same way, and the same way as the saved world did as long as every
+    // island had at most one contact and nothing was about to fall asleep
+    // (Box2D keeps contact solve order and sleep timers private). Returns
+    // false, leaving the world untouched, when the data is malformed.
+    bool restore_snapshot(const uint8_t* data, size_t size);
 
 private:
-    std::unique_ptr<b2World> m_world;
-    std::unique_ptr<MyContactListener> m_contact_listener;
-    std::unordered_map<BodyId, b2Body*> m_bodies;
-    std::vector<CollisionEvent> m_collision_events;
-    BodyId m_next_body_id = 1;
-
-    const float m_timeStep = 1.0f / 60.0f;
-    const int32_t m_velocityIterations = 6;
-    const int32_t m_positionIterations = 2;
+    // Per-body activity as of the last refresh_body_states().
+    enum BodyActivity : uint8_t {
+        BODY_ASLEEP,
+        BODY_AWAKE,
+        BODY_NEW, // not yet published
+    };
+
+    struct Partition {
+        std::unique_ptr<b2World> world;
+        // Written only by the thread stepping this partition.
+        std::unique_ptr<MyContactListener> contact_listener;
+    };
+
+    BodyId register_body(b2Body* body);
+    void refresh_body_states();
+    void step_partition(size_t index);
+    // Calls run(begin, end) over [0, count), split across the job system
+    // for large batches.
+    void run_query_batches(size_t count, const std::function<void(size_t, size_t)>& run) const;
+
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    jobs::JobSystem* m_jobs = nullptr;
+    bool m_deterministic = true;
+    // Partition indices in the order their steps finished.
+    std::vector<size_t> m_step_order;
+    std::atomic<size_t> m_steps_finished{0};
+    // Creation-order walk of a world's body list, reused by save_snapshot.
+    mutable std::vector<const b2Body*> m_snapshot_bodies;
+    // Generational ids; m_bodies, m_body_states and m_body_activity are
+    // parallel to its dense range.
+    BodySlotMap m_body_ids;
+    std::vector<b2Body*> m_bodies;
+    std::vector<BodyState> m_body_states;
+    std::vector<uint8_t> m_body_activity;
+    std::vector<BodyState> m_moved_body_states;
+    EventArena<CollisionEvent> m_collision_events;
+    bool m_reported_event_overflow = false;
+
+    float m_timeStep = 1.0f / 60.0f;
+    int32_t m_velocityIterations = 6;
+    int32_t m_positionIterations = 2;
+    uint32_t m_subSteps = 1;
+    bool m_continuous = true;
+    float m_budgetMs = 0.0f; // 0: adaptive mode off
+    // Quality in use for the next step and the adaptive state behind it.
+    AdaptiveStepQuality m_quality;
 };
 
 }
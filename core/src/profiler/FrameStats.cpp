@@ -0,0 +1,140 @@
+#include "profiler/FrameStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace miyabi {
+namespace profiler {
+
+FrameTimeHistogram::FrameTimeHistogram(size_t window_frames)
+    : m_buckets(BUCKET_COUNT, 0),
+      m_window(window_frames, 0.0),
+      m_next(0),
+      m_frames(0),
+      m_sum_ms(0.0),
+      m_min_ms(0.0),
+      m_max_ms(0.0) {}
+
+size_t FrameTimeHistogram::bucket_for(double frame_ms) {
+    if (!(frame_ms > 0.0)) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(frame_ms / BUCKET_MS), BUCKET_COUNT - 1);
+}
+
+void FrameTimeHistogram::add(double frame_ms) {
+    frame_ms = std::max(frame_ms, 0.0);
+    if (m_window.empty()) {
+        m_min_ms = m_frames == 0 ? frame_ms : std::min(m_min_ms, frame_ms);
+        m_max_ms = std::max(m_max_ms, frame_ms);
+        ++m_frames;
+    } else {
+        if (m_frames == m_window.size()) {
+            const double evicted = m_window[m_next];
+            --m_buckets[bucket_for(evicted)];
+            m_sum_ms -= evicted;
+        } else {
+            ++m_frames;
+        }
+        m_window[m_next] = frame_ms;
+        m_next = (m_next + 1) % m_window.size();
+    }
+    ++m_buckets[bucket_for(frame_ms)];
+    m_sum_ms += frame_ms;
+}
+
+double FrameTimeHistogram::min_ms() const {
+    if (!m_window.empty()) {
+        const auto end = m_window.begin() + static_cast<std::ptrdiff_t>(m_frames);
+        return m_frames == 0 ? 0.0 : *std::min_element(m_window.begin(), end);
+    }
+    return m_min_ms;
+}
+
+double FrameTimeHistogram::percentile(double fraction) const {
+    const uint64_t rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(static_cast<double>(m_frames) * fraction)));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT - 1; ++bucket) {
+        seen += m_buckets[bucket];
+        if (seen >= rank) {
+            return static_cast<double>(bucket + 1) * BUCKET_MS;
+        }
+    }
+    // Only the overflow bucket is left; its upper edge is the max.
+    return std::numeric_limits<double>::infinity();
+}
+
+FrameTimePercentiles FrameTimeHistogram::percentiles() const {
+    FrameTimePercentiles result;
+    if (m_frames == 0) {
+        return result;
+    }
+    result.frames = m_frames;
+    if (!m_window.empty()) {
+        const auto end = m_window.begin() + static_cast<std::ptrdiff_t>(m_frames);
+        result.max_ms = *std::max_element(m_window.begin(), end);
+    } else {
+        result.max_ms = m_max_ms;
+    }
+    result.p50_ms = std::min(percentile(0.50), result.max_ms);
+    result.p95_ms = std::min(percentile(0.95), result.max_ms);
+    result.p99_ms = std::min(percentile(0.99), result.max_ms);
+    return result;
+}
+
+FrameStats::FrameStats(double budget_ms)
+    : m_window(WINDOW_FRAMES),
+      m_total(0),
+      m_budget_ms(budget_ms),
+      m_frame_index(0),
+      m_hitches(0),
+      m_window_hitches(0) {}
+
+bool FrameStats::add_frame(double frame_ms) {
+    ++m_frame_index;
+    m_window.add(frame_ms);
+    m_total.add(frame_ms);
+    if (frame_ms <= m_budget_ms) {
+        return false;
+    }
+    ++m_hitches;
+    ++m_window_hitches;
+    return true;
+}
+
+bool FrameStats::write_json(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "FrameStats::write_json - cannot open " << path << std::endl;
+        return false;
+    }
+    const FrameTimePercentiles summary = m_total.percentiles();
+    const double avg_ms = summary.frames > 0 ? m_total.sum_ms() / static_cast<double>(summary.frames) : 0.0;
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n"
+        << "  \"schema_version\": 1,\n"
+        << "  \"source\": \"core/src/profiler/FrameStats.cpp\",\n"
+        << "  \"budget_ms\": " << m_budget_ms << ",\n"
+        << "  \"hitches\": " << m_hitches << ",\n"
+        << "  \"scenarios\": [\n"
+        << "    {\n"
+        << "      \"name\": \"frame_time\",\n"
+        << "      \"avg_ms\": " << avg_ms << ",\n"
+        << "      \"p50_ms\": " << summary.p50_ms << ",\n"
+        << "      \"p95_ms\": " << summary.p95_ms << ",\n"
+        << "      \"p99_ms\": " << summary.p99_ms << ",\n"
+        << "      \"min_ms\": " << m_total.min_ms() << ",\n"
+        << "      \"max_ms\": " << summary.max_ms << ",\n"
+        << "      \"iterations\": " << summary.frames << "\n"
+        << "    }\n"
+        << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace profiler
+} // namespace miyabi
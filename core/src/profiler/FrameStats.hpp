@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace miyabi {
+namespace profiler {
+
+struct FrameTimePercentiles {
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+    uint64_t frames = 0;
+};
+
+// Frame times bucketed at BUCKET_MS resolution, either over the last
+// `window_frames` frames or, with a window of 0, over every frame added.
+// Percentiles are nearest rank on bucket upper edges (so they never
+// under-report) and max is exact.
+class FrameTimeHistogram {
+public:
+    static constexpr double BUCKET_MS = 0.1;
+    static constexpr size_t BUCKET_COUNT = 1000; // the last bucket holds >= 99.9 ms
+
+    explicit FrameTimeHistogram(size_t window_frames);
+
+    void add(double frame_ms);
+
+    FrameTimePercentiles percentiles() const;
+    uint64_t frames() const { return m_frames; }
+    double sum_ms() const { return m_sum_ms; }
+    double min_ms() const;
+
+private:
+    static size_t bucket_for(double frame_ms);
+    double percentile(double fraction) const;
+
+    std::vector<uint64_t> m_buckets;
+    std::vector<double> m_window;   // ring of the windowed samples
+    size_t m_next;
+    uint64_t m_frames;              // frames currently counted
+    double m_sum_ms;
+    double m_min_ms;                // cumulative mode only
+    double m_max_ms;                // cumulative mode only
+};
+
+// Per-frame bookkeeping for the main loop: a rolling histogram for the
+// periodic log, a cumulative one for the exit summary, and hitch counting
+// against a frame budget.
+class FrameStats {
+public:
+    static constexpr size_t WINDOW_FRAMES = 600;
+
+    explicit FrameStats(double budget_ms);
+
+    // Returns true when the frame exceeded the budget (a hitch).
+    bool add_frame(double frame_ms);
+
+    const FrameTimeHistogram& window() const { return m_window; }
+    const FrameTimeHistogram& total() const { return m_total; }
+    double budget_ms() const { return m_budget_ms; }
+    uint64_t frame_index() const { return m_frame_index; }
+    uint64_t hitches() const { return m_hitches; }
+    uint64_t window_hitches() const { return m_window_hitches; }
+    // Resets the per-log-interval hitch count.
+    void reset_window_hitches() { m_window_hitches = 0; }
+
+    // Perf report schema (scenario "frame_time"), plus p50/p99 and hitch
+    // counts for monitoring.
+    bool write_json(const std::string& path) const;
+
+private:
+    FrameTimeHistogram m_window;
+    FrameTimeHistogram m_total;
+    double m_budget_ms;
+    uint64_t m_frame_index;
+    uint64_t m_hitches;
+    uint64_t m_window_hitches;
+};
+
+} // namespace profiler
+} // namespace miyabi
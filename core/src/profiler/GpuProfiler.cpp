@@ -0,0 +1,172 @@
+#include "profiler/GpuProfiler.hpp"
+
+#include <glad/glad.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace miyabi {
+namespace profiler {
+
+namespace {
+void write_scenario(std::ostream& out, const std::string& name, const TimingSummary& summary, bool& first) {
+    if (!first) {
+        out << ",\n";
+    }
+    first = false;
+    out << "    {\n"
+        << "      \"name\": \"" << name << "\",\n"
+        << "      \"avg_ms\": " << summary.avg_ms << ",\n"
+        << "      \"p95_ms\": " << summary.p95_ms << ",\n"
+        << "      \"min_ms\": " << summary.min_ms << ",\n"
+        << "      \"max_ms\": " << summary.max_ms << ",\n"
+        << "      \"iterations\": " << summary.iterations << "\n"
+        << "    }";
+}
+} // namespace
+
+GpuProfiler::GpuProfiler()
+    : m_enabled(false),
+      m_frame_index(0),
+      m_dropped_results(0) {}
+
+GpuProfiler::~GpuProfiler() = default;
+
+void GpuProfiler::shutdown() {
+    for (FrameSlot& slot : m_frames) {
+        if (!slot.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+        }
+        slot.queries.clear();
+        slot.scopes.clear();
+        slot.used_queries = 0;
+    }
+    m_open_scopes.clear();
+    m_enabled = false;
+}
+
+bool GpuProfiler::init() {
+    GLint counter_bits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counter_bits);
+    m_enabled = counter_bits > 0;
+    if (!m_enabled) {
+        std::cerr << "Warning::GpuProfiler: GL_TIMESTAMP has no counter bits; GPU timing disabled" << std::endl;
+    }
+    return m_enabled;
+}
+
+void GpuProfiler::begin_frame() {
+    if (!m_enabled) {
+        return;
+    }
+    if (!m_open_scopes.empty()) {
+        std::cerr << "Warning::GpuProfiler: " << m_open_scopes.size()
+                  << " scope(s) left open at frame end" << std::endl;
+        m_open_scopes.clear();
+    }
+    ++m_frame_index;
+    collect(m_frames[m_frame_index % FRAMES_IN_FLIGHT]);
+}
+
+void GpuProfiler::begin_scope(const std::string& name) {
+    if (!m_enabled) {
+        return;
+    }
+    const std::string full_name = m_open_scopes.empty()
+        ? name
+        : m_stats[m_open_scopes.back().stats_index].name + "/" + name;
+    const uint32_t begin_query = acquire_query();
+    glQueryCounter(begin_query, GL_TIMESTAMP);
+    m_open_scopes.push_back({ stats_index_for(full_name), begin_query, std::chrono::steady_clock::now() });
+}
+
+void GpuProfiler::end_scope() {
+    if (!m_enabled || m_open_scopes.empty()) {
+        return;
+    }
+    const OpenScope open = m_open_scopes.back();
+    m_open_scopes.pop_back();
+
+    const uint32_t end_query = acquire_query();
+    glQueryCounter(end_query, GL_TIMESTAMP);
+    const double cpu_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - open.cpu_start).count();
+    m_frames[m_frame_index % FRAMES_IN_FLIGHT].scopes.push_back(
+        { open.stats_index, open.begin_query, end_query, cpu_ms });
+}
+
+std::vector<GpuScopeReport> GpuProfiler::report() const {
+    std::vector<GpuScopeReport> reports;
+    reports.reserve(m_stats.size());
+    for (const ScopeStats& stats : m_stats) {
+        reports.push_back({ stats.name, stats.gpu_ms.summarize(), stats.cpu_ms.summarize() });
+    }
+    return reports;
+}
+
+bool GpuProfiler::write_json(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "GpuProfiler::write_json - cannot open " << path << std::endl;
+        return false;
+    }
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n"
+        << "  \"schema_version\": 1,\n"
+        << "  \"source\": \"core/src/profiler/GpuProfiler.cpp\",\n"
+        << "  \"dropped_gpu_results\": " << m_dropped_results << ",\n"
+        << "  \"scenarios\": [\n";
+    bool first = true;
+    for (const GpuScopeReport& scope : report()) {
+        write_scenario(out, "gpu." + scope.name, scope.gpu, first);
+        write_scenario(out, "cpu." + scope.name, scope.cpu, first);
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+uint32_t GpuProfiler::acquire_query() {
+    FrameSlot& slot = m_frames[m_frame_index % FRAMES_IN_FLIGHT];
+    if (slot.used_queries == slot.queries.size()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        slot.queries.push_back(query);
+    }
+    return slot.queries[slot.used_queries++];
+}
+
+uint32_t GpuProfiler::stats_index_for(const std::string& full_name) {
+    auto it = m_stats_by_name.find(full_name);
+    if (it != m_stats_by_name.end()) {
+        return it->second;
+    }
+    const uint32_t index = static_cast<uint32_t>(m_stats.size());
+    m_stats.push_back({ full_name, TimingSamples(SAMPLE_CAPACITY), TimingSamples(SAMPLE_CAPACITY) });
+    m_stats_by_name.emplace(full_name, index);
+    return index;
+}
+
+void GpuProfiler::collect(FrameSlot& slot) {
+    for (const IssuedScope& scope : slot.scopes) {
+        // Queries complete in order, so the end query being ready implies
+        // the begin query is too.
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(scope.end_query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            ++m_dropped_results;
+            continue;
+        }
+        GLuint64 begin_ns = 0;
+        GLuint64 end_ns = 0;
+        glGetQueryObjectui64v(scope.begin_query, GL_QUERY_RESULT, &begin_ns);
+        glGetQueryObjectui64v(scope.end_query, GL_QUERY_RESULT, &end_ns);
+        ScopeStats& stats = m_stats[scope.stats_index];
+        stats.gpu_ms.add(end_ns >= begin_ns ? static_cast<double>(end_ns - begin_ns) / 1.0e6 : 0.0);
+        stats.cpu_ms.add(scope.cpu_ms);
+    }
+    slot.scopes.clear();
+    slot.used_queries = 0;
+}
+
+} // namespace profiler
+} // namespace miyabi
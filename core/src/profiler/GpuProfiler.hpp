@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "profiler/TimingStats.hpp"
+
+namespace miyabi {
+namespace profiler {
+
+// GPU execution time of a named scope, next to the CPU time spent issuing
+// its commands.
+struct GpuScopeReport {
+    std::string name;       // nested scopes are "parent/child"
+    TimingSummary gpu;
+    TimingSummary cpu;
+};
+
+// Brackets render passes with GL_TIMESTAMP queries. Each frame writes into
+// one slot of a FRAMES_IN_FLIGHT ring and results are read back only when
+// that slot comes around again, so collecting never waits on the GPU; a
+// result that is still not available then is dropped and counted.
+// Timestamps (unlike GL_TIME_ELAPSED) allow nested scopes, e.g. per batch
+// inside a pass.
+class GpuProfiler {
+public:
+    static constexpr uint32_t FRAMES_IN_FLIGHT = 4;
+    static constexpr size_t SAMPLE_CAPACITY = 600; // ~10 s at 60 fps
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Needs a current GL context. Returns false (all calls become no-ops)
+    // when the driver reports no timestamp counter bits.
+    bool init();
+    // Deletes the query pools; call while the context is still current
+    // (before glfwTerminate). The destructor makes no GL calls. Reports and
+    // write_json() keep working afterwards.
+    void shutdown();
+    bool enabled() const { return m_enabled; }
+
+    // Collects the results of the frame issued FRAMES_IN_FLIGHT frames ago.
+    void begin_frame();
+
+    void begin_scope(const std::string& name);
+    void end_scope();
+
+    std::vector<GpuScopeReport> report() const;
+    uint64_t dropped_results() const { return m_dropped_results; }
+
+    // Writes the scopes in the perf report schema checked by
+    // tools/check_perf_regression.py, as "gpu.<scope>" and "cpu.<scope>"
+    // scenarios. Returns false if the file cannot be written.
+    bool write_json(const std::string& path) const;
+
+private:
+    struct ScopeStats {
+        std::string name;
+        TimingSamples gpu_ms;
+        TimingSamples cpu_ms;
+    };
+
+    struct IssuedScope {
+        uint32_t stats_index;
+        uint32_t begin_query;
+        uint32_t end_query;
+        double cpu_ms;
+    };
+
+    struct OpenScope {
+        uint32_t stats_index;
+        uint32_t begin_query;
+        std::chrono::steady_clock::time_point cpu_start;
+    };
+
+    struct FrameSlot {
+        std::vector<IssuedScope> scopes;
+        std::vector<uint32_t> queries;  // pool, reused every time the slot comes around
+        size_t used_queries = 0;
+    };
+
+    uint32_t acquire_query();
+    uint32_t stats_index_for(const std::string& full_name);
+    void collect(FrameSlot& slot);
+
+    bool m_enabled;
+    uint64_t m_frame_index;
+    FrameSlot m_frames[FRAMES_IN_FLIGHT];
+    std::vector<OpenScope> m_open_scopes;
+    std::vector<ScopeStats> m_stats;
+    std::unordered_map<std::string, uint32_t> m_stats_by_name;
+    uint64_t m_dropped_results;
+};
+
+// RAII bracket for GpuProfiler::begin_scope / end_scope.
+class GpuScope {
+public:
+    GpuScope(GpuProfiler& profiler, const std::string& name) : m_profiler(profiler) {
+        m_profiler.begin_scope(name);
+    }
+    ~GpuScope() { m_profiler.end_scope(); }
+
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+
+private:
+    GpuProfiler& m_profiler;
+};
+
+} // namespace profiler
+} // namespace miyabi
+
+#ifdef MIYABI_PROFILE
+#define MIYABI_GPU_PROFILE_CONCAT_INNER(a, b) a##b
+#define MIYABI_GPU_PROFILE_CONCAT(a, b) MIYABI_GPU_PROFILE_CONCAT_INNER(a, b)
+// Times the rest of the enclosing scope on the GPU.
+#define MIYABI_GPU_PROFILE_SCOPE(gpu_profiler, name) \
+    miyabi::profiler::GpuScope MIYABI_GPU_PROFILE_CONCAT(gpu_scope_, __LINE__)(gpu_profiler, name)
+#else
+#define MIYABI_GPU_PROFILE_SCOPE(gpu_profiler, name)
+#endif
@@ -0,0 +1,350 @@
+#include "profiler/Profiler.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace miyabi {
+namespace profiler {
+
+namespace {
+void write_json_string(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (const char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << ' ';
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+// Retires the thread's ring when the thread exits. Only touched when a
+// thread registers, so scopes never pay for its destructor guard.
+struct RingRetirer {
+    ThreadEventRing* ring = nullptr;
+    ~RingRetirer() {
+        if (ring) {
+            t_thread_ring = nullptr;
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+} // namespace
+
+ThreadEventRing* register_current_thread() {
+    static thread_local RingRetirer retirer;
+    ThreadEventRing* ring = Profiler::instance().add_thread();
+    retirer.ring = ring;
+    t_thread_ring = ring;
+    return ring;
+}
+
+void set_thread_name(const std::string& name) {
+    Profiler::instance().rename_thread(current_thread_ring(), name);
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : m_capture_frames_left(0),
+      m_capture_frames(0),
+      m_calibration_ticks(now_ticks()),
+      m_calibration_time(std::chrono::steady_clock::now()),
+      m_ns_per_tick(1.0) {}
+
+ThreadEventRing* Profiler::add_thread() {
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    // A recycled ring keeps its thread index, so its scopes go on
+    // aggregating under the new thread's name.
+    for (ThreadState& thread : m_threads) {
+        if (thread.reusable) {
+            thread.reusable = false;
+            ThreadEventRing& ring = *thread.ring;
+            ring.retired.store(false, std::memory_order_relaxed);
+            ring.recorded_depth = 0;
+            ring.suppressed_depth = 0;
+            ring.thread_name = "thread-" + std::to_string(ring.thread_index);
+            return &ring;
+        }
+    }
+    ThreadState state;
+    state.ring = std::make_unique<ThreadEventRing>();
+    state.ring->thread_index = static_cast<uint32_t>(m_threads.size());
+    state.ring->thread_name = m_threads.empty() ? "main" : "thread-" + std::to_string(m_threads.size());
+    m_threads.push_back(std::move(state));
+    return m_threads.back().ring.get();
+}
+
+void Profiler::rename_thread(ThreadEventRing* ring, const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    ring->thread_name = name;
+}
+
+void Profiler::calibrate() {
+#if defined(MIYABI_PROFILE_TICKS_RDTSC) || defined(MIYABI_PROFILE_TICKS_CNTVCT)
+    // Two-point calibration against steady_clock since startup; the ratio
+    // gets more precise the longer the process runs.
+    const uint64_t ticks = now_ticks();
+    const auto elapsed_ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - m_calibration_time).count();
+    if (ticks > m_calibration_ticks && elapsed_ns > 1.0e6) {
+        m_ns_per_tick = elapsed_ns / static_cast<double>(ticks - m_calibration_ticks);
+    }
+#endif
+}
+
+void Profiler::collect() {
+    calibrate();
+    const double ms_per_tick = m_ns_per_tick / 1.0e6;
+    for (ScopeNode& node : m_nodes) {
+        node.collect_ms = 0.0;
+        node.collect_calls = 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_threads_mutex);
+        for (ThreadState& thread : m_threads) {
+            ThreadEventRing& ring = *thread.ring;
+            // Loaded before the drain: a retired thread writes nothing after
+            // setting the flag, so the drain below empties its ring.
+            const bool retired = !thread.reusable && ring.retired.load(std::memory_order_acquire);
+            const uint64_t read = ring.read.load(std::memory_order_relaxed);
+            const uint64_t write = ring.write.load(std::memory_order_acquire);
+            for (uint64_t i = read; i < write; ++i) {
+                const ScopeEvent& event = ring.events[i & ThreadEventRing::MASK];
+                if (event.name) {
+                    const uint32_t parent = thread.open_scopes.empty() ? NO_PARENT : thread.open_scopes.back().node;
+                    thread.open_scopes.push_back({ node_for(ring.thread_index, parent, event.name), event.ticks });
+                    continue;
+                }
+                if (thread.open_scopes.empty()) {
+                    continue;
+                }
+                const OpenScope open = thread.open_scopes.back();
+                thread.open_scopes.pop_back();
+                const double ms = event.ticks > open.begin_ticks
+                    ? static_cast<double>(event.ticks - open.begin_ticks) * ms_per_tick
+                    : 0.0;
+                ScopeNode& node = m_nodes[open.node];
+                node.samples.add(ms);
+                node.collect_ms += ms;
+                ++node.collect_calls;
+                if (m_capture_frames_left > 0) {
+                    m_capture.push_back({
+                        open.node,
+                        open.begin_ticks,
+                        event.ticks,
+                    });
+                }
+            }
+            ring.read.store(write, std::memory_order_release);
+            if (retired) {
+                thread.open_scopes.clear();
+                thread.reusable = true;
+            }
+        }
+    }
+
+    // Written outside the lock: finish_capture() reads thread names.
+    if (m_capture_frames_left > 0 && --m_capture_frames_left == 0) {
+        finish_capture();
+    }
+}
+
+bool Profiler::start_capture(uint32_t frames, const std::string& path) {
+    if (m_capture_frames_left > 0 || frames == 0) {
+        return false;
+    }
+    m_capture.clear();
+    m_captured_counters.clear();
+    // Counters start their tracks at their current value.
+    const uint64_t ticks = now_ticks();
+    for (size_t i = 0; i < m_counters.size(); ++i) {
+        m_captured_counters.push_back({ static_cast<uint32_t>(i), ticks, m_counters[i].value });
+    }
+    m_capture_path = path;
+    m_capture_frames = frames;
+    m_capture_frames_left = frames;
+    std::cout << "[profile.trace] capture_start frames=" << frames << " path=" << path << std::endl;
+    return true;
+}
+
+void Profiler::finish_capture() {
+    const std::filesystem::path output(m_capture_path);
+    std::error_code ec;
+    if (output.has_parent_path()) {
+        std::filesystem::create_directories(output.parent_path(), ec);
+    }
+    std::ofstream out(m_capture_path);
+    if (!out) {
+        std::cerr << "Profiler::finish_capture - cannot open " << m_capture_path << std::endl;
+        m_capture.clear();
+        m_captured_counters.clear();
+        return;
+    }
+
+    // Complete ("X") and counter ("C") events in microseconds since
+    // profiler start; one thread_name metadata event per thread so tracks
+    // are labelled.
+    const double us_per_tick = m_ns_per_tick / 1000.0;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(m_threads_mutex);
+        for (const ThreadState& thread : m_threads) {
+            out << (first ? "" : ",\n")
+                << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.ring->thread_index
+                << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+            write_json_string(out, thread.ring->thread_name);
+            out << "}}";
+            first = false;
+        }
+    }
+    for (const CapturedScope& scope : m_capture) {
+        const ScopeNode& node = m_nodes[scope.node];
+        const size_t name_start = node.path.rfind('/');
+        const uint64_t begin = scope.begin_ticks > m_calibration_ticks ? scope.begin_ticks - m_calibration_ticks : 0;
+        const uint64_t duration = scope.end_ticks > scope.begin_ticks ? scope.end_ticks - scope.begin_ticks : 0;
+        out << (first ? "" : ",\n")
+            << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << node.thread_index
+            << ",\"ts\":" << static_cast<double>(begin) * us_per_tick
+            << ",\"dur\":" << static_cast<double>(duration) * us_per_tick
+            << ",\"name\":";
+        write_json_string(out, name_start == std::string::npos ? node.path : node.path.substr(name_start + 1));
+        out << "}";
+        first = false;
+    }
+    for (const CapturedCounter& counter : m_captured_counters) {
+        const uint64_t ticks = counter.ticks > m_calibration_ticks ? counter.ticks - m_calibration_ticks : 0;
+        out << (first ? "" : ",\n")
+            << "{\"ph\":\"C\",\"pid\":1,\"tid\":0"
+            << ",\"ts\":" << static_cast<double>(ticks) * us_per_tick
+            << ",\"name\":";
+        write_json_string(out, m_counters[counter.counter].name);
+        out << ",\"args\":{\"value\":" << counter.value << "}}";
+        first = false;
+    }
+    out << "\n]}\n";
+
+    std::cout << "[profile.trace] capture_done frames=" << m_capture_frames
+              << " scopes=" << m_capture.size()
+              << " path=" << m_capture_path << std::endl;
+    m_capture.clear();
+    m_captured_counters.clear();
+}
+
+void Profiler::set_counter(const char* name, double value) {
+    size_t index = 0;
+    while (index < m_counters.size() && m_counters[index].name != name
+           && std::strcmp(m_counters[index].name, name) != 0) {
+        ++index;
+    }
+    if (index == m_counters.size()) {
+        m_counters.push_back({ name, value });
+    } else if (m_counters[index].value == value) {
+        return;
+    } else {
+        m_counters[index].value = value;
+    }
+    if (m_capture_frames_left > 0) {
+        m_captured_counters.push_back({ static_cast<uint32_t>(index), now_ticks(), value });
+    }
+}
+
+std::vector<CounterReport> Profiler::counters() const {
+    std::vector<CounterReport> reports;
+    reports.reserve(m_counters.size());
+    for (const Counter& counter : m_counters) {
+        reports.push_back({ counter.name, counter.value });
+    }
+    return reports;
+}
+
+std::vector<ScopeReport> Profiler::report() const {
+    std::vector<ScopeReport> reports;
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    for (size_t thread_index = 0; thread_index < m_threads.size(); ++thread_index) {
+        // Depth-first so every parent precedes its children.
+        std::vector<uint32_t> stack;
+        for (uint32_t i = static_cast<uint32_t>(m_nodes.size()); i-- > 0;) {
+            if (m_nodes[i].thread_index == thread_index && m_nodes[i].parent == NO_PARENT) {
+                stack.push_back(i);
+            }
+        }
+        while (!stack.empty()) {
+            const uint32_t index = stack.back();
+            stack.pop_back();
+            const ScopeNode& node = m_nodes[index];
+            reports.push_back({
+                m_threads[thread_index].ring->thread_name,
+                node.path,
+                node.depth,
+                node.samples.summarize(),
+                node.collect_ms,
+                node.collect_calls,
+            });
+            for (uint32_t child = static_cast<uint32_t>(m_nodes.size()); child-- > 0;) {
+                if (m_nodes[child].parent == index) {
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+    return reports;
+}
+
+uint64_t Profiler::dropped_events() const {
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    uint64_t dropped = 0;
+    for (const ThreadState& thread : m_threads) {
+        dropped += thread.ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+uint32_t Profiler::node_for(uint32_t thread_index, uint32_t parent, const char* name) {
+    const auto key = std::make_tuple(thread_index, parent, name);
+    auto it = m_nodes_by_key.find(key);
+    if (it != m_nodes_by_key.end()) {
+        return it->second;
+    }
+
+    const std::string path = parent == NO_PARENT ? std::string(name) : m_nodes[parent].path + "/" + name;
+    const std::string path_key = std::to_string(thread_index) + "\n" + path;
+    uint32_t index;
+    auto path_it = m_nodes_by_path.find(path_key);
+    if (path_it != m_nodes_by_path.end()) {
+        index = path_it->second;
+    } else {
+        index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back({
+            thread_index,
+            parent,
+            parent == NO_PARENT ? 0 : m_nodes[parent].depth + 1,
+            path,
+            TimingSamples(WINDOW_SAMPLES),
+            0.0,
+            0,
+        });
+        m_nodes_by_path.emplace(path_key, index);
+    }
+    m_nodes_by_key.emplace(key, index);
+    return index;
+}
+
+} // namespace profiler
+} // namespace miyabi
@@ -1,56 +1,268 @@
 #pragma once
 
-#ifdef MIYABI_PROFILE
-#include <iostream>
-#include <string>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define MIYABI_PROFILE_TICKS_RDTSC 1
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+#define MIYABI_PROFILE_TICKS_CNTVCT 1
+#endif
+
+#include "profiler/TimingStats.hpp"
 
 namespace miyabi {
 namespace profiler {
 
-    class Timer
-    {
-    public:
-        Timer(const char* name)
-            : m_Name(name), m_Stopped(false)
-        {
-            m_StartTimepoint = std::chrono::high_resolution_clock::now();
-        }
+// Raw timestamp for scope events: the TSC on x86, the virtual counter on
+// ARM64, steady_clock nanoseconds elsewhere. Converted to milliseconds only
+// when events are collected, calibrated against steady_clock.
+inline uint64_t now_ticks() {
+#if defined(MIYABI_PROFILE_TICKS_RDTSC)
+    return __rdtsc();
+#elif defined(MIYABI_PROFILE_TICKS_CNTVCT)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// One begin (name set) or end (name == nullptr) record.
+struct ScopeEvent {
+    const char* name;
+    uint64_t ticks;
+};
+
+// Single-producer/single-consumer ring owned by one thread. The owning
+// thread appends events; Profiler::collect() drains them on the main thread.
+// When the ring is full new scopes are dropped, never the end of a scope
+// that is already recorded, so the begin/end stream always stays balanced.
+struct ThreadEventRing {
+    static constexpr uint64_t CAPACITY = 8192; // power of two
+    static constexpr uint64_t MASK = CAPACITY - 1;
+
+    ScopeEvent events[CAPACITY];
+    std::atomic<uint64_t> write{0};
+    std::atomic<uint64_t> read{0};
+    std::atomic<uint64_t> dropped{0};
+    // Set when the owning thread exits; collect() drains the ring and then
+    // hands it to the next thread that registers.
+    std::atomic<bool> retired{false};
+    // Producer-only bookkeeping.
+    uint32_t recorded_depth = 0;
+    uint32_t suppressed_depth = 0;
+    uint32_t thread_index = 0;
+    std::string thread_name;
+};
+
+// Registers the calling thread (reusing a retired ring if there is one)
+// and sets t_thread_ring; out of line.
+ThreadEventRing* register_current_thread();
+
+// The calling thread's ring, or nullptr before its first scope. Constant
+// initialized, so reading it is a plain TLS load without an init guard.
+inline thread_local ThreadEventRing* t_thread_ring = nullptr;
+
+inline ThreadEventRing* current_thread_ring() {
+    ThreadEventRing* ring = t_thread_ring;
+    if (!ring) {
+        ring = register_current_thread();
+    }
+    return ring;
+}
+
+// Names the calling thread in reports (default "main" for the first thread
+// to record, "thread-<n>" for others).
+void set_thread_name(const std::string& name);
+
+inline void begin_scope(ThreadEventRing* ring, const char* name) {
+    const uint64_t write = ring->write.load(std::memory_order_relaxed);
+    const uint64_t used = write - ring->read.load(std::memory_order_acquire);
+    // Keep room for the end events of every scope already open.
+    if (ring->suppressed_depth > 0 || used + ring->recorded_depth + 2 > ThreadEventRing::CAPACITY) {
+        ++ring->suppressed_depth;
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->events[write & ThreadEventRing::MASK] = { name, now_ticks() };
+    ring->write.store(write + 1, std::memory_order_release);
+    ++ring->recorded_depth;
+}
+
+inline void end_scope(ThreadEventRing* ring) {
+    if (ring->suppressed_depth > 0) {
+        --ring->suppressed_depth;
+        return;
+    }
+    const uint64_t write = ring->write.load(std::memory_order_relaxed);
+    ring->events[write & ThreadEventRing::MASK] = { nullptr, now_ticks() };
+    ring->write.store(write + 1, std::memory_order_release);
+    --ring->recorded_depth;
+}
+
+inline void begin_scope(const char* name) { begin_scope(current_thread_ring(), name); }
+inline void end_scope() { end_scope(current_thread_ring()); }
+
+// RAII scope; `name` must outlive the profiler (string literals). Looks
+// the ring up once for both events.
+class ScopeTimer {
+public:
+    explicit ScopeTimer(const char* name) : m_ring(current_thread_ring()) { begin_scope(m_ring, name); }
+    ~ScopeTimer() { end_scope(m_ring); }
+
+    ScopeTimer(const ScopeTimer&) = delete;
+    ScopeTimer& operator=(const ScopeTimer&) = delete;
+
+private:
+    ThreadEventRing* m_ring;
+};
 
-        ~Timer()
-        {
-            if (!m_Stopped)
-                Stop();
-        }
+struct ScopeReport {
+    std::string thread;
+    std::string path;           // "Frame/Render", relative to the thread
+    uint32_t depth = 0;         // 0 for top-level scopes
+    TimingSummary window;       // per call, over the last WINDOW_SAMPLES calls
+    double last_collect_ms = 0.0;     // total time completed in the last collect()
+    uint32_t last_collect_calls = 0;
+};
 
-        void Stop()
-        {
-            auto endTimepoint = std::chrono::high_resolution_clock::now();
+struct CounterReport {
+    std::string name;
+    double value = 0.0;
+};
 
-            long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
-            long long end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
+// Aggregates scope events from every thread into a per-thread scope tree.
+class Profiler {
+public:
+    static constexpr size_t WINDOW_SAMPLES = 300;
 
-            float duration = (end - start) * 0.001f; // Convert to milliseconds
+    static Profiler& instance();
 
-            std::cout << "[PROFILE] " << m_Name << ": " << duration << "ms\n";
+    // Drains all thread rings and updates scope statistics. Call once per
+    // frame from the main thread, outside of any scope it should report.
+    void collect();
 
-            m_Stopped = true;
-        }
+    // Scopes in tree order (parents before children), per thread.
+    std::vector<ScopeReport> report() const;
 
-    private:
-        const char* m_Name;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_StartTimepoint;
-        bool m_Stopped;
+    uint64_t dropped_events() const;
+    double ns_per_tick() const { return m_ns_per_tick; }
+
+    // Sets a named value (a quality level, a count, ...) that is reported
+    // next to the scopes and written to trace captures as a counter track
+    // whenever it changes. Main thread only; `name` must outlive the
+    // profiler (string literals).
+    void set_counter(const char* name, double value);
+    // Latest value of every counter, in first-set order.
+    std::vector<CounterReport> counters() const;
+
+    // Records every scope completed during the next `frames` collect() calls
+    // (from all threads) and then writes them to `path` as Chrome trace-event
+    // JSON, viewable in Perfetto or about:tracing. Returns false if a
+    // capture is already running.
+    bool start_capture(uint32_t frames, const std::string& path);
+    bool capturing() const { return m_capture_frames_left > 0; }
+
+    // Used by register_current_thread / set_thread_name.
+    ThreadEventRing* add_thread();
+    void rename_thread(ThreadEventRing* ring, const std::string& name);
+
+private:
+    struct ScopeNode {
+        uint32_t thread_index;
+        uint32_t parent;        // NO_PARENT for top-level scopes
+        uint32_t depth;
+        std::string path;
+        TimingSamples samples;
+        double collect_ms;
+        uint32_t collect_calls;
+    };
+
+    struct OpenScope {
+        uint32_t node;
+        uint64_t begin_ticks;
+    };
+
+    struct ThreadState {
+        std::unique_ptr<ThreadEventRing> ring;
+        std::vector<OpenScope> open_scopes;
+        bool reusable = false; // retired and fully drained
+    };
+
+    struct CapturedScope {
+        uint32_t node;
+        uint64_t begin_ticks;
+        uint64_t end_ticks;
+    };
+
+    struct Counter {
+        const char* name;
+        double value;
     };
 
+    struct CapturedCounter {
+        uint32_t counter;
+        uint64_t ticks;
+        double value;
+    };
+
+    static constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    Profiler();
+    void calibrate();
+    uint32_t node_for(uint32_t thread_index, uint32_t parent, const char* name);
+    void finish_capture();
+
+    mutable std::mutex m_threads_mutex;     // guards m_threads growth and names
+    std::vector<ThreadState> m_threads;
+    std::vector<ScopeNode> m_nodes;
+    // (thread, parent, name pointer) -> node; the path map merges equal
+    // names that arrive through different literal addresses.
+    std::map<std::tuple<uint32_t, uint32_t, const char*>, uint32_t> m_nodes_by_key;
+    std::unordered_map<std::string, uint32_t> m_nodes_by_path;
+
+    std::vector<Counter> m_counters;
+
+    std::vector<CapturedScope> m_capture;
+    std::vector<CapturedCounter> m_captured_counters;
+    std::string m_capture_path;
+    uint32_t m_capture_frames_left;
+    uint32_t m_capture_frames;
+
+    uint64_t m_calibration_ticks;
+    std::chrono::steady_clock::time_point m_calibration_time;
+    double m_ns_per_tick;
+};
+
 } // namespace profiler
 } // namespace miyabi
 
-// A macro to easily profile a scope
-#define MIYABI_PROFILE_SCOPE(name) miyabi::profiler::Timer timer##__LINE__(name)
-
+#ifdef MIYABI_PROFILE
+#define MIYABI_PROFILE_CONCAT_INNER(a, b) a##b
+#define MIYABI_PROFILE_CONCAT(a, b) MIYABI_PROFILE_CONCAT_INNER(a, b)
+// Records the enclosing scope: two ring writes, no I/O.
+#define MIYABI_PROFILE_SCOPE(name) \
+    ::miyabi::profiler::ScopeTimer MIYABI_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define MIYABI_PROFILE_COUNTER(name, value) \
+    ::miyabi::profiler::Profiler::instance().set_counter(name, static_cast<double>(value))
 #else
-// If profiling is disabled, the macro does nothing.
+// If profiling is disabled, the macros do nothing.
 #define MIYABI_PROFILE_SCOPE(name)
-
+#define MIYABI_PROFILE_COUNTER(name, value)
 #endif
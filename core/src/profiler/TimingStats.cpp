@@ -0,0 +1,69 @@
+#include "profiler/TimingStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace miyabi {
+namespace profiler {
+
+namespace {
+double nearest_rank(const std::vector<double>& sorted, double fraction) {
+    const size_t count = sorted.size();
+    const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(count)));
+    return sorted[std::min(count, std::max<size_t>(rank, 1)) - 1];
+}
+} // namespace
+
+TimingSamples::TimingSamples(size_t capacity)
+    : m_samples(std::max<size_t>(capacity, 1), 0.0),
+      m_next(0),
+      m_count(0) {}
+
+void TimingSamples::add(double ms) {
+    m_samples[m_next] = ms;
+    m_next = (m_next + 1) % m_samples.size();
+    m_count = std::min(m_count + 1, m_samples.size());
+}
+
+void TimingSamples::clear() {
+    m_next = 0;
+    m_count = 0;
+}
+
+double TimingSamples::last() const {
+    if (m_count == 0) {
+        return 0.0;
+    }
+    return m_samples[(m_next + m_samples.size() - 1) % m_samples.size()];
+}
+
+TimingSummary TimingSamples::summarize() const {
+    // Until the ring wraps, only [0, m_count) holds samples.
+    return summarize_timings(std::vector<double>(m_samples.begin(), m_samples.begin() + m_count));
+}
+
+TimingSummary summarize_timings(std::vector<double> samples_ms) {
+    TimingSummary summary;
+    if (samples_ms.empty()) {
+        return summary;
+    }
+    std::sort(samples_ms.begin(), samples_ms.end());
+
+    double total = 0.0;
+    for (double sample : samples_ms) {
+        total += sample;
+    }
+    const size_t count = samples_ms.size();
+
+    summary.avg_ms = total / static_cast<double>(count);
+    summary.p50_ms = nearest_rank(samples_ms, 0.50);
+    summary.p95_ms = nearest_rank(samples_ms, 0.95);
+    summary.p99_ms = nearest_rank(samples_ms, 0.99);
+    summary.min_ms = samples_ms.front();
+    summary.max_ms = samples_ms.back();
+    summary.iterations = static_cast<uint32_t>(count);
+    return summary;
+}
+
+} // namespace profiler
+} // namespace miyabi
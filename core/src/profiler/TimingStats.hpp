@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace miyabi {
+namespace profiler {
+
+// Same fields as a perf report scenario (logic/src/perf.rs PerfScenarioResult),
+// plus the median and p99 for reports that track tail latency.
+struct TimingSummary {
+    double avg_ms = 0.0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double min_ms = 0.0;
+    double max_ms = 0.0;
+    uint32_t iterations = 0;
+};
+
+// Fixed-capacity ring of millisecond samples; the oldest is overwritten.
+class TimingSamples {
+public:
+    explicit TimingSamples(size_t capacity);
+
+    void add(double ms);
+    void clear();
+
+    size_t size() const { return m_count; }
+    size_t capacity() const { return m_samples.size(); }
+    // Most recent sample, or 0 when empty.
+    double last() const;
+
+    TimingSummary summarize() const;
+
+private:
+    std::vector<double> m_samples;
+    size_t m_next;
+    size_t m_count;
+};
+
+// Nearest-rank percentiles, matching the Rust perf baseline. All zero when
+// empty.
+TimingSummary summarize_timings(std::vector<double> samples_ms);
+
+} // namespace profiler
+} // namespace miyabi
@@ -1,9 +1,43 @@
 #include "renderer/FontManager.hpp"
 #include <iostream>
 #include <glad/glad.h>
-#include <numeric>
 
-FontManager::FontManager() : m_ft(nullptr), m_face(nullptr), m_atlas_texture_id(0) {
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11)
+#define MIYABI_FREETYPE_HAS_SDF 1
+#endif
+
+namespace {
+// 1024x1024 single-channel pages: ~400 glyphs at 48px each, 1 MiB per page.
+constexpr uint32_t ATLAS_PAGE_SIZE = 1024;
+constexpr uint32_t ATLAS_MAX_PAGES = 4;
+constexpr char32_t WARMUP_FIRST_CODEPOINT = 0x20;
+constexpr char32_t WARMUP_LAST_CODEPOINT = 0x7E;
+
+// Uploads happen on cache misses in the middle of text rendering, so the
+// caller's texture binding must survive them.
+class ScopedTextureBindingRestore {
+public:
+    ScopedTextureBindingRestore() {
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_previous);
+    }
+    ~ScopedTextureBindingRestore() {
+        glBindTexture(GL_TEXTURE_2D, static_cast<unsigned int>(m_previous));
+    }
+
+private:
+    int m_previous = 0;
+};
+} // namespace
+
+FontManager::FontManager()
+    : m_ft(nullptr),
+      m_face(nullptr),
+      m_pixel_size(0),
+      m_line_height(0),
+      m_render_mode(FontRenderMode::Bitmap),
+      m_atlas(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, ATLAS_MAX_PAGES),
+      m_frame(0),
+      m_atlas_generation(0) {
     if (FT_Init_FreeType(&m_ft)) {
         std::cerr << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
     }
@@ -14,10 +48,13 @@ FontManager::~FontManager() {
 }
 
 void FontManager::cleanup() {
-    if (m_atlas_texture_id != 0) {
-        glDeleteTextures(1, &m_atlas_texture_id);
-        m_atlas_texture_id = 0;
+    if (!m_page_texture_ids.empty()) {
+        glDeleteTextures(static_cast<int>(m_page_texture_ids.size()), m_page_texture_ids.data());
+        m_page_texture_ids.clear();
     }
+    m_page_glyphs.clear();
+    m_glyphs.clear();
+    m_atlas.clear();
     if (m_face) {
         FT_Done_Face(m_face);
         m_face = nullptr;
@@ -28,87 +65,211 @@ void FontManager::cleanup() {
     }
 }
 
-bool FontManager::load_font(const std::string& path, unsigned int font_size) {
+bool FontManager::load_font(const std::string& path, unsigned int font_size, FontRenderMode mode) {
     if (!m_ft) {
         std::cerr << "ERROR::FREETYPE: Library not initialized." << std::endl;
         return false;
     }
-    if (FT_New_Face(m_ft, path.c_str(), 0, &m_face)) {
+    FT_Face face = nullptr;
+    if (FT_New_Face(m_ft, path.c_str(), 0, &face)) {
         std::cerr << "ERROR::FREETYPE: Failed to load font: " << path << std::endl;
         return false;
     }
 
+    // Replacing the face invalidates every cached glyph.
+    if (m_face) {
+        FT_Done_Face(m_face);
+    }
+    if (!m_page_texture_ids.empty()) {
+        glDeleteTextures(static_cast<int>(m_page_texture_ids.size()), m_page_texture_ids.data());
+        m_page_texture_ids.clear();
+    }
+    m_page_glyphs.clear();
+    m_glyphs.clear();
+    m_atlas.clear();
+    ++m_atlas_generation;
+
+#if !defined(MIYABI_FREETYPE_HAS_SDF)
+    if (mode == FontRenderMode::Sdf) {
+        std::cerr << "Warning::FontManager: FreeType " << FREETYPE_MAJOR << "." << FREETYPE_MINOR
+                  << " has no SDF rasterizer (needs 2.11+); falling back to bitmap glyphs." << std::endl;
+        mode = FontRenderMode::Bitmap;
+    }
+#endif
+
+    m_face = face;
+    m_pixel_size = font_size;
+    m_render_mode = mode;
     FT_Set_Pixel_Sizes(m_face, 0, font_size);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    m_line_height = static_cast<unsigned int>(m_face->size->metrics.height >> 6);
 
-    unsigned int atlas_width = 0;
-    unsigned int atlas_height = 0;
+    for (char32_t c = WARMUP_FIRST_CODEPOINT; c <= WARMUP_LAST_CODEPOINT; ++c) {
+        get_glyph(c);
+    }
 
-    // First pass: calculate atlas dimensions
-    for (unsigned char c = 0; c < 128; c++) {
-        if (FT_Load_Char(m_face, c, FT_LOAD_RENDER)) {
-            std::cerr << "Warning::FREETYPE: Failed to load Glyph for character: " << c << std::endl;
-            continue;
+    return true;
+}
+
+void FontManager::begin_frame() {
+    ++m_frame;
+}
+
+const Character* FontManager::get_glyph(char32_t codepoint) {
+    auto it = m_glyphs.find(codepoint);
+    if (it != m_glyphs.end()) {
+        if (it->second.Size.x > 0 && it->second.Size.y > 0) {
+            m_atlas.touch(it->second.Page, m_frame);
         }
-        atlas_width += m_face->glyph->bitmap.width;
-        atlas_height = std::max(atlas_height, m_face->glyph->bitmap.rows);
+        return &it->second;
     }
+    return rasterize_glyph(codepoint);
+}
 
-    // Create the texture atlas
-    glGenTextures(1, &m_atlas_texture_id);
-    glBindTexture(GL_TEXTURE_2D, m_atlas_texture_id);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlas_width, atlas_height, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+int FontManager::get_kerning(char32_t left, char32_t right) const {
+    if (!m_face || !FT_HAS_KERNING(m_face)) {
+        return 0;
+    }
+    FT_Vector delta = { 0, 0 };
+    if (FT_Get_Kerning(
+            m_face,
+            FT_Get_Char_Index(m_face, left),
+            FT_Get_Char_Index(m_face, right),
+            FT_KERNING_DEFAULT,
+            &delta)) {
+        return 0;
+    }
+    return static_cast<int>(delta.x >> 6);
+}
 
-    // Set texture options
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+void FontManager::touch_page(uint32_t page) {
+    if (page < m_atlas.page_count()) {
+        m_atlas.touch(page, m_frame);
+    }
+}
+
+unsigned int FontManager::get_page_texture_id(uint32_t page) const {
+    return page < m_page_texture_ids.size() ? m_page_texture_ids[page] : 0;
+}
+
+const Character* FontManager::rasterize_glyph(char32_t codepoint) {
+    if (!m_face) {
+        return nullptr;
+    }
+    FT_Error error = FT_Load_Char(m_face, codepoint, FT_LOAD_DEFAULT);
+    if (!error) {
+#if defined(MIYABI_FREETYPE_HAS_SDF)
+        const FT_Render_Mode render_mode =
+            m_render_mode == FontRenderMode::Sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL;
+#else
+        const FT_Render_Mode render_mode = FT_RENDER_MODE_NORMAL;
+#endif
+        error = FT_Render_Glyph(m_face->glyph, render_mode);
+    }
+    if (error) {
+        std::cerr << "Warning::FREETYPE: Failed to load Glyph for codepoint: U+"
+                  << std::hex << static_cast<uint32_t>(codepoint) << std::dec << std::endl;
+        return nullptr;
+    }
+
+    const FT_GlyphSlot glyph = m_face->glyph;
+    const uint32_t width = glyph->bitmap.width;
+    const uint32_t rows = glyph->bitmap.rows;
 
-    // Second pass: fill the texture atlas
-    int x_offset = 0;
-    for (unsigned char c = 0; c < 128; c++) {
-        if (FT_Load_Char(m_face, c, FT_LOAD_RENDER)) {
-            continue; // Warning already issued in first pass
+    Character character = {
+        { static_cast<int>(width), static_cast<int>(rows) },
+        // bitmap_left/top include the SDF spread margin, unlike horiBearing.
+        { glyph->bitmap_left, glyph->bitmap_top },
+        static_cast<unsigned int>(glyph->advance.x / 64),
+        { 0.0f, 0.0f },
+        { 0.0f, 0.0f },
+        0
+    };
+
+    if (width > 0 && rows > 0) {
+        const GlyphAtlasAllocation allocation = m_atlas.allocate(width, rows, m_frame);
+        if (!allocation.ok) {
+            std::cerr << "Warning::FontManager: glyph atlas saturated this frame, dropping U+"
+                      << std::hex << static_cast<uint32_t>(codepoint) << std::dec << std::endl;
+            return nullptr;
         }
 
-        if (m_face->glyph->bitmap.width > 0 && m_face->glyph->bitmap.rows > 0) {
-            glTexSubImage2D(GL_TEXTURE_2D, 0, x_offset, 0, m_face->glyph->bitmap.width, m_face->glyph->bitmap.rows, GL_RED, GL_UNSIGNED_BYTE, m_face->glyph->bitmap.buffer);
+        const GlyphAtlasRegion& region = allocation.region;
+        ScopedTextureBindingRestore binding_restore;
+        if (allocation.created_page) {
+            create_page_texture();
+        }
+        if (allocation.evicted_page) {
+            clear_page(region.page);
         }
 
-        // Calculate texture coordinates
-        vec2 tex_coords_start = {
-            (float)x_offset / (float)atlas_width,
-            0.0f
+        glBindTexture(GL_TEXTURE_2D, m_page_texture_ids[region.page]);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, glyph->bitmap.pitch);
+        glTexSubImage2D(
+            GL_TEXTURE_2D, 0,
+            static_cast<int>(region.x), static_cast<int>(region.y),
+            static_cast<int>(width), static_cast<int>(rows),
+            GL_RED, GL_UNSIGNED_BYTE, glyph->bitmap.buffer
+        );
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+        const float page_width = static_cast<float>(m_atlas.page_width());
+        const float page_height = static_cast<float>(m_atlas.page_height());
+        character.TexCoordsStart = {
+            static_cast<float>(region.x) / page_width,
+            static_cast<float>(region.y) / page_height
         };
-        vec2 tex_coords_end = {
-            (float)(x_offset + m_face->glyph->bitmap.width) / (float)atlas_width,
-            (float)m_face->glyph->bitmap.rows / (float)atlas_height
+        character.TexCoordsEnd = {
+            static_cast<float>(region.x + width) / page_width,
+            static_cast<float>(region.y + rows) / page_height
         };
+        character.Page = region.page;
+        m_page_glyphs[region.page].push_back(codepoint);
+    }
 
-        // Store character
-        Character character = {
-            { (int)m_face->glyph->bitmap.width, (int)m_face->glyph->bitmap.rows },
-            { static_cast<int>(m_face->glyph->metrics.horiBearingX / 64), static_cast<int>(m_face->glyph->metrics.horiBearingY / 64) },
-            (unsigned int)(m_face->glyph->advance.x / 64),
-            tex_coords_start,
-            tex_coords_end
-        };
-        m_characters.insert(std::pair<char, Character>(c, character));
+    return &m_glyphs.emplace(codepoint, character).first->second;
+}
 
-        x_offset += m_face->glyph->bitmap.width;
-    }
+void FontManager::create_page_texture() {
+    const std::vector<unsigned char> zeroes(
+        static_cast<size_t>(m_atlas.page_width()) * m_atlas.page_height(), 0);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    // FT_Done_Face(m_face); // Keep face loaded for now
+    unsigned int texture_id = 0;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(
+        GL_TEXTURE_2D, 0, GL_RED,
+        static_cast<int>(m_atlas.page_width()), static_cast<int>(m_atlas.page_height()),
+        0, GL_RED, GL_UNSIGNED_BYTE, zeroes.data()
+    );
 
-    return true;
-}
+    // Set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-const Character& FontManager::get_character(char c) const {
-    return m_characters.at(c);
+    m_page_texture_ids.push_back(texture_id);
+    m_page_glyphs.emplace_back();
 }
 
-unsigned int FontManager::get_atlas_texture_id() const {
-    return m_atlas_texture_id;
-}
\ No newline at end of file
+void FontManager::clear_page(uint32_t page) {
+    for (const char32_t codepoint : m_page_glyphs[page]) {
+        m_glyphs.erase(codepoint);
+    }
+    m_page_glyphs[page].clear();
+    ++m_atlas_generation;
+
+    // Stale texels in the padding gutters would bleed into new glyphs under
+    // linear filtering, so the whole page is zeroed.
+    const std::vector<unsigned char> zeroes(
+        static_cast<size_t>(m_atlas.page_width()) * m_atlas.page_height(), 0);
+    glBindTexture(GL_TEXTURE_2D, m_page_texture_ids[page]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(
+        GL_TEXTURE_2D, 0, 0, 0,
+        static_cast<int>(m_atlas.page_width()), static_cast<int>(m_atlas.page_height()),
+        GL_RED, GL_UNSIGNED_BYTE, zeroes.data()
+    );
+}
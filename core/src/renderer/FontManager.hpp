@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
+#include "renderer/GlyphAtlas.hpp"
+
 // A simple struct for 2D integer vectors.
 struct ivec2 {
     int x, y;
@@ -16,13 +20,23 @@ struct vec2 {
 };
 
 // Holds all state information relevant to a character.
-// This data is relative to the texture atlas.
+// This data is relative to the texture atlas page the glyph lives on.
 struct Character {
     ivec2   Size;      // Size of glyph
     ivec2   Bearing;   // Offset from baseline to left/top of glyph
     unsigned int Advance;   // Horizontal offset to advance to next glyph
-    vec2    TexCoordsStart; // Top-left texture coordinate in the atlas
-    vec2    TexCoordsEnd;   // Bottom-right texture coordinate in the atlas
+    vec2    TexCoordsStart; // Top-left texture coordinate in the atlas page
+    vec2    TexCoordsEnd;   // Bottom-right texture coordinate in the atlas page
+    uint32_t Page;          // Atlas page index (see get_page_texture_id)
+};
+
+// How glyph bitmaps are stored in the atlas.
+enum class FontRenderMode {
+    // Coverage bitmaps; crisp only near the rasterized pixel size.
+    Bitmap,
+    // Signed distance fields (edge at 0.5); one atlas scales to any size.
+    // Requires FreeType 2.11+, otherwise load_font falls back to Bitmap.
+    Sdf,
 };
 
 class FontManager {
@@ -30,21 +44,58 @@ public:
     FontManager();
     ~FontManager();
 
-    // Loads a font, generates a texture atlas for the first 128 ASCII characters.
+    // Loads a font face. Glyphs are rasterized lazily on first use; only
+    // printable ASCII is warmed up front so HUD text does not hitch.
     // Returns true on success, false on failure.
-    bool load_font(const std::string& path, unsigned int font_size);
+    bool load_font(const std::string& path, unsigned int font_size, FontRenderMode mode = FontRenderMode::Bitmap);
+
+    // Advances the LRU clock. Call once per frame before any get_glyph().
+    void begin_frame();
+
+    // Retrieves the glyph for a Unicode code point, rasterizing it into the
+    // atlas on a cache miss. Returns nullptr if the glyph cannot be produced
+    // (no face loaded, FreeType error, or the atlas is saturated this frame).
+    const Character* get_glyph(char32_t codepoint);
+
+    // Gets the OpenGL texture ID backing an atlas page.
+    unsigned int get_page_texture_id(uint32_t page) const;
 
-    // Retrieves the character information for a given character.
-    const Character& get_character(char c) const;
+    // Pixel size the glyphs were rasterized at.
+    unsigned int get_pixel_size() const { return m_pixel_size; }
 
-    // Gets the OpenGL ID of the texture atlas.
-    unsigned int get_atlas_texture_id() const;
+    // Mode the current atlas was generated with.
+    FontRenderMode get_render_mode() const { return m_render_mode; }
+
+    // Distance between baselines, in pixels at the rasterized size.
+    unsigned int get_line_height() const { return m_line_height; }
+
+    // Horizontal kerning adjustment between two code points, in pixels.
+    int get_kerning(char32_t left, char32_t right) const;
+
+    // Bumped whenever previously returned glyph placements may have become
+    // stale (font reload or page eviction). Cached layouts compare against it.
+    uint64_t get_atlas_generation() const { return m_atlas_generation; }
+
+    // Marks a page as used this frame without looking up a glyph, so layouts
+    // replayed from a cache keep their pages resident.
+    void touch_page(uint32_t page);
 
 private:
+    const Character* rasterize_glyph(char32_t codepoint);
+    void create_page_texture();
+    void clear_page(uint32_t page);
+
     FT_Library m_ft;
     FT_Face m_face;
-    std::unordered_map<char, Character> m_characters;
-    unsigned int m_atlas_texture_id;
+    unsigned int m_pixel_size;
+    unsigned int m_line_height;
+    FontRenderMode m_render_mode;
+    GlyphAtlas m_atlas;
+    std::unordered_map<char32_t, Character> m_glyphs;
+    std::vector<unsigned int> m_page_texture_ids;
+    std::vector<std::vector<char32_t>> m_page_glyphs;
+    uint64_t m_frame;
+    uint64_t m_atlas_generation;
 
     void cleanup();
 };
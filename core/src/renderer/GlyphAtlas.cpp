@@ -0,0 +1,110 @@
+#include "renderer/GlyphAtlas.hpp"
+
+#include <limits>
+
+GlyphAtlas::GlyphAtlas(uint32_t page_width, uint32_t page_height, uint32_t max_pages, uint32_t padding)
+    : m_page_width(page_width),
+      m_page_height(page_height),
+      m_max_pages(max_pages),
+      m_padding(padding) {}
+
+bool GlyphAtlas::try_allocate_on_page(
+    Page& page,
+    uint32_t width,
+    uint32_t height,
+    uint32_t& out_x,
+    uint32_t& out_y
+) {
+    const uint32_t padded_width = width + m_padding;
+    const uint32_t padded_height = height + m_padding;
+
+    // Best fit: the lowest existing shelf that is tall enough and has room left.
+    Shelf* best_shelf = nullptr;
+    for (auto& shelf : page.shelves) {
+        if (shelf.height < padded_height || shelf.cursor_x + padded_width > m_page_width) {
+            continue;
+        }
+        if (best_shelf == nullptr || shelf.height < best_shelf->height) {
+            best_shelf = &shelf;
+        }
+    }
+
+    // Avoid parking small glyphs on very tall shelves when a new shelf still fits.
+    const bool wasteful = best_shelf != nullptr && best_shelf->height > padded_height * 2;
+    const bool can_open_shelf =
+        page.next_shelf_y + padded_height <= m_page_height && padded_width <= m_page_width;
+    if (best_shelf == nullptr || (wasteful && can_open_shelf)) {
+        if (!can_open_shelf) {
+            return false;
+        }
+        page.shelves.push_back(Shelf{page.next_shelf_y, padded_height, 0});
+        page.next_shelf_y += padded_height;
+        best_shelf = &page.shelves.back();
+    }
+
+    out_x = best_shelf->cursor_x;
+    out_y = best_shelf->y;
+    best_shelf->cursor_x += padded_width;
+    return true;
+}
+
+GlyphAtlasAllocation GlyphAtlas::allocate(uint32_t width, uint32_t height, uint64_t frame) {
+    GlyphAtlasAllocation result;
+    if (width + m_padding > m_page_width || height + m_padding > m_page_height) {
+        return result;
+    }
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    for (uint32_t page_index = 0; page_index < m_pages.size(); ++page_index) {
+        if (try_allocate_on_page(m_pages[page_index], width, height, x, y)) {
+            m_pages[page_index].last_used_frame = frame;
+            result.ok = true;
+            result.region = GlyphAtlasRegion{page_index, x, y, width, height};
+            return result;
+        }
+    }
+
+    if (m_pages.size() < m_max_pages) {
+        m_pages.emplace_back();
+        const uint32_t page_index = static_cast<uint32_t>(m_pages.size() - 1);
+        try_allocate_on_page(m_pages[page_index], width, height, x, y);
+        m_pages[page_index].last_used_frame = frame;
+        result.ok = true;
+        result.created_page = true;
+        result.region = GlyphAtlasRegion{page_index, x, y, width, height};
+        return result;
+    }
+
+    uint32_t lru_page = std::numeric_limits<uint32_t>::max();
+    uint64_t lru_frame = std::numeric_limits<uint64_t>::max();
+    for (uint32_t page_index = 0; page_index < m_pages.size(); ++page_index) {
+        const uint64_t last_used = m_pages[page_index].last_used_frame;
+        if (last_used < frame && last_used < lru_frame) {
+            lru_frame = last_used;
+            lru_page = page_index;
+        }
+    }
+    if (lru_page == std::numeric_limits<uint32_t>::max()) {
+        // Every page is referenced by the current frame.
+        return result;
+    }
+
+    m_pages[lru_page] = Page{};
+    try_allocate_on_page(m_pages[lru_page], width, height, x, y);
+    m_pages[lru_page].last_used_frame = frame;
+    result.ok = true;
+    result.evicted_page = true;
+    result.region = GlyphAtlasRegion{lru_page, x, y, width, height};
+    return result;
+}
+
+void GlyphAtlas::touch(uint32_t page, uint64_t frame) {
+    if (page < m_pages.size() && m_pages[page].last_used_frame < frame) {
+        m_pages[page].last_used_frame = frame;
+    }
+}
+
+void GlyphAtlas::clear() {
+    m_pages.clear();
+}
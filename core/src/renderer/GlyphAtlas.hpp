@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Location of a glyph bitmap inside one atlas page, in texels.
+struct GlyphAtlasRegion {
+    uint32_t page;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct GlyphAtlasAllocation {
+    bool ok = false;
+    GlyphAtlasRegion region{};
+    // True when the region lives on a page that did not exist before this call.
+    bool created_page = false;
+    // True when a least-recently-used page was reset to make room.
+    // Every glyph previously stored on `region.page` is invalid afterwards.
+    bool evicted_page = false;
+};
+
+// Shelf packer for a multi-page glyph atlas. Pure bookkeeping (no GL calls),
+// so FontManager owns the textures and this class only decides where glyphs go.
+// Pages are recycled whole in LRU order; a page touched during the current
+// frame is never evicted, so quads already queued for that frame stay valid.
+class GlyphAtlas {
+public:
+    GlyphAtlas(uint32_t page_width, uint32_t page_height, uint32_t max_pages, uint32_t padding = 1);
+
+    // Reserves a width x height region. `frame` is the caller's frame counter
+    // and marks the chosen page as used.
+    GlyphAtlasAllocation allocate(uint32_t width, uint32_t height, uint64_t frame);
+
+    // Marks a page as used during `frame` (keeps it away from eviction).
+    void touch(uint32_t page, uint64_t frame);
+
+    // Drops every shelf on every page.
+    void clear();
+
+    uint32_t page_count() const { return static_cast<uint32_t>(m_pages.size()); }
+    uint32_t page_width() const { return m_page_width; }
+    uint32_t page_height() const { return m_page_height; }
+    uint32_t max_pages() const { return m_max_pages; }
+
+private:
+    struct Shelf {
+        uint32_t y;
+        uint32_t height;
+        uint32_t cursor_x;
+    };
+
+    struct Page {
+        std::vector<Shelf> shelves;
+        uint32_t next_shelf_y = 0;
+        uint64_t last_used_frame = 0;
+    };
+
+    bool try_allocate_on_page(Page& page, uint32_t width, uint32_t height, uint32_t& out_x, uint32_t& out_y);
+
+    uint32_t m_page_width;
+    uint32_t m_page_height;
+    uint32_t m_max_pages;
+    uint32_t m_padding;
+    std::vector<Page> m_pages;
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Dense slot array addressed by 32-bit generational handles, for the
+// resource registries (meshes, textures, shaders, materials) looked up on
+// every draw batch.
+//
+// A handle is `generation << 24 | index`. Slot 0 is reserved so that 0
+// stays the invalid id, and generations start at 0, so the first handle of a
+// slot equals its index: ids that are fixed in the logic crate (quad mesh 1,
+// arena cube 100, materials 1 and 2) keep working unchanged. remove() bumps
+// the slot's generation, so handles to a removed resource no longer resolve
+// even after the slot is reused.
+constexpr uint32_t HANDLE_INDEX_BITS = 24;
+constexpr uint32_t HANDLE_INDEX_MASK = (1u << HANDLE_INDEX_BITS) - 1u;
+
+// Slot index of a handle, for side tables kept parallel to a pool.
+inline uint32_t handle_index(uint32_t handle) { return handle & HANDLE_INDEX_MASK; }
+
+template <typename T>
+class HandlePool {
+public:
+    static constexpr uint32_t INDEX_BITS = HANDLE_INDEX_BITS;
+    static constexpr uint32_t INDEX_MASK = HANDLE_INDEX_MASK;
+    static constexpr uint32_t MAX_GENERATION = 0xFFu;
+
+    static uint32_t index_of(uint32_t handle) { return handle_index(handle); }
+    static uint32_t generation_of(uint32_t handle) { return handle >> INDEX_BITS; }
+
+    HandlePool() : m_values(1), m_generations(1, 0), m_occupied(1, 0), m_live_count(0) {}
+
+    // Stores `value` in a free slot (reusing removed ones first) and returns
+    // its handle, or 0 once all 2^24 - 1 slots are in use.
+    uint32_t insert(T value) {
+        uint32_t index;
+        if (!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else {
+            if (m_values.size() > INDEX_MASK) {
+                return 0;
+            }
+            index = static_cast<uint32_t>(m_values.size());
+            grow(index + 1);
+        }
+        return occupy(index, std::move(value));
+    }
+
+    // Stores `value` in an explicit slot, for ids shared with the logic
+    // crate. Returns 0 if `index` is 0, out of range or already in use.
+    uint32_t insert_at(uint32_t index, T value) {
+        if (index == 0 || index > INDEX_MASK) {
+            return 0;
+        }
+        if (index >= m_values.size()) {
+            const uint32_t first_gap = static_cast<uint32_t>(m_values.size());
+            grow(index + 1);
+            // Skipped slots stay available to insert(), lowest first.
+            for (uint32_t gap = index; gap-- > first_gap;) {
+                m_free.push_back(gap);
+            }
+        }
+        if (m_occupied[index]) {
+            return 0;
+        }
+        auto it = std::find(m_free.begin(), m_free.end(), index);
+        if (it != m_free.end()) {
+            m_free.erase(it);
+        }
+        return occupy(index, std::move(value));
+    }
+
+    // Frees the slot and invalidates every copy of `handle`.
+    bool remove(uint32_t handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        const uint32_t index = index_of(handle);
+        m_values[index] = T{};
+        m_occupied[index] = 0;
+        --m_live_count;
+        // A slot whose generation would wrap is retired instead of reused,
+        // so an old handle can never alias a new resource.
+        if (m_generations[index] < MAX_GENERATION) {
+            ++m_generations[index];
+            m_free.push_back(index);
+        }
+        return true;
+    }
+
+    bool contains(uint32_t handle) const {
+        const uint32_t index = index_of(handle);
+        return index != 0
+            && index < m_values.size()
+            && m_occupied[index]
+            && m_generations[index] == generation_of(handle);
+    }
+
+    // O(1); nullptr for 0, unknown or stale handles.
+    T* get(uint32_t handle) {
+        return contains(handle) ? &m_values[index_of(handle)] : nullptr;
+    }
+    const T* get(uint32_t handle) const {
+        return contains(handle) ? &m_values[index_of(handle)] : nullptr;
+    }
+
+    size_t size() const { return m_live_count; }
+
+    // Visits live entries in slot order as f(handle, value).
+    template <typename F>
+    void for_each(F&& f) {
+        for (uint32_t index = 1; index < m_values.size(); ++index) {
+            if (m_occupied[index]) {
+                f(make_handle(index), m_values[index]);
+            }
+        }
+    }
+    template <typename F>
+    void for_each(F&& f) const {
+        for (uint32_t index = 1; index < m_values.size(); ++index) {
+            if (m_occupied[index]) {
+                f(make_handle(index), m_values[index]);
+            }
+        }
+    }
+
+private:
+    uint32_t make_handle(uint32_t index) const {
+        return (static_cast<uint32_t>(m_generations[index]) << INDEX_BITS) | index;
+    }
+
+    uint32_t occupy(uint32_t index, T value) {
+        m_values[index] = std::move(value);
+        m_occupied[index] = 1;
+        ++m_live_count;
+        return make_handle(index);
+    }
+
+    void grow(size_t slot_count) {
+        m_values.resize(slot_count);
+        m_generations.resize(slot_count, 0);
+        m_occupied.resize(slot_count, 0);
+    }
+
+    std::vector<T> m_values;
+    std::vector<uint8_t> m_generations;
+    std::vector<uint8_t> m_occupied;
+    std::vector<uint32_t> m_free;
+    size_t m_live_count;
+};
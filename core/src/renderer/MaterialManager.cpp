@@ -1,30 +1,107 @@
 #include "renderer/MaterialManager.hpp"
+#include "renderer/RenderBatching.hpp"
+#include <glad/glad.h>
 #include <iostream>
 
-MaterialManager::MaterialManager() : m_next_material_id(1) {}
+MaterialManager::MaterialManager()
+    : m_sort_keys(1, 0),
+      m_params_dirty(false),
+      m_material_ubo(0),
+      m_frame_ubo(0) {}
 
-MaterialManager::~MaterialManager() = default;
+MaterialManager::~MaterialManager() {
+    if (m_material_ubo != 0) {
+        glDeleteBuffers(1, &m_material_ubo);
+    }
+    if (m_frame_ubo != 0) {
+        glDeleteBuffers(1, &m_frame_ubo);
+    }
+}
 
-uint32_t MaterialManager::create_material(uint32_t shader_id) {
-    uint32_t material_id = m_next_material_id++;
-    m_materials[material_id] = { shader_id, 0 };
+uint32_t MaterialManager::create_material(uint32_t shader_id, uint32_t render_state) {
+    if (m_params.size() >= MAX_MATERIALS) {
+        std::cerr << "MaterialManager::create_material - MaterialBlock arena is full. max="
+                  << MAX_MATERIALS << std::endl;
+        return 0;
+    }
+    const uint32_t material_id = m_materials.insert(
+        Material{ shader_id, 0, render_state, static_cast<uint32_t>(m_params.size()), 0 });
+    if (material_id == 0) {
+        return 0;
+    }
+    m_params.push_back(MaterialParams{});
+    m_params_dirty = true;
+    if (m_sort_keys.size() <= handle_index(material_id)) {
+        m_sort_keys.resize(handle_index(material_id) + 1, 0);
+    }
+    refresh_sort_key(material_id, *m_materials.get(material_id));
     return material_id;
 }
 
 void MaterialManager::set_texture(uint32_t material_id, uint32_t texture_id) {
-    auto it = m_materials.find(material_id);
-    if (it != m_materials.end()) {
-        it->second.texture_id = texture_id;
+    if (Material* material = m_materials.get(material_id)) {
+        material->texture_id = texture_id;
+        refresh_sort_key(material_id, *material);
     } else {
         std::cerr << "MaterialManager::set_texture - Material ID " << material_id << " not found." << std::endl;
     }
 }
 
+void MaterialManager::set_render_state(uint32_t material_id, uint32_t render_state) {
+    if (Material* material = m_materials.get(material_id)) {
+        material->render_state = render_state;
+        refresh_sort_key(material_id, *material);
+    } else {
+        std::cerr << "MaterialManager::set_render_state - Material ID " << material_id << " not found." << std::endl;
+    }
+}
+
+void MaterialManager::set_params(uint32_t material_id, const MaterialParams& params) {
+    if (Material* material = m_materials.get(material_id)) {
+        m_params[material->block_index] = params;
+        m_params_dirty = true;
+    } else {
+        std::cerr << "MaterialManager::set_params - Material ID " << material_id << " not found." << std::endl;
+    }
+}
+
 Material* MaterialManager::get_material(uint32_t material_id) {
-    auto it = m_materials.find(material_id);
-    if (it != m_materials.end()) {
-        return &it->second;
+    if (Material* material = m_materials.get(material_id)) {
+        return material;
     }
     std::cerr << "MaterialManager::get_material - Material ID " << material_id << " not found." << std::endl;
     return nullptr;
 }
+
+void MaterialManager::upload_material_blocks() {
+    if (m_material_ubo == 0) {
+        // Sized for the whole arena once, so growth never reallocates.
+        glGenBuffers(1, &m_material_ubo);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_material_ubo);
+        glBufferData(GL_UNIFORM_BUFFER, MAX_MATERIALS * sizeof(MaterialParams), nullptr, GL_DYNAMIC_DRAW);
+        m_params_dirty = true;
+    }
+    if (m_params_dirty && !m_params.empty()) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_material_ubo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, m_params.size() * sizeof(MaterialParams), m_params.data());
+        m_params_dirty = false;
+    }
+    glBindBufferBase(GL_UNIFORM_BUFFER, MATERIAL_BLOCK_BINDING, m_material_ubo);
+}
+
+void MaterialManager::upload_frame_params(const FrameParams& params) {
+    if (m_frame_ubo == 0) {
+        glGenBuffers(1, &m_frame_ubo);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_frame_ubo);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameParams), nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frame_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameParams), &params);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, m_frame_ubo);
+}
+
+void MaterialManager::refresh_sort_key(uint32_t material_id, Material& material) {
+    material.sort_key = make_material_sort_key(
+        material.render_state, material.shader_id, material.texture_id, material_id);
+    m_sort_keys[handle_index(material_id)] = material.sort_key;
+}
@@ -1,28 +1,92 @@
 #pragma once
 
 #include <cstdint>
-#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "renderer/HandlePool.hpp"
+
+// Uniform block binding points shared by ShaderManager and the draw loop.
+constexpr uint32_t FRAME_BLOCK_BINDING = 0;
+constexpr uint32_t MATERIAL_BLOCK_BINDING = 1;
+
+// Fixed-function state a material needs; part of its sort key.
+enum MaterialRenderState : uint32_t {
+    MATERIAL_STATE_NONE = 0,
+    MATERIAL_STATE_DEPTH_TEST = 1u << 0,
+    MATERIAL_STATE_ALPHA_BLEND = 1u << 1,
+};
+
+// One entry of `MaterialBlock` in standard.frag (std140, 32 bytes).
+struct MaterialParams {
+    glm::vec4 base_color = glm::vec4(1.0f);
+    float ambient_strength = 1.0f;
+    float diffuse_strength = 0.0f;
+    float alpha_cutoff = 0.5f;
+    float padding = 0.0f;
+};
+static_assert(sizeof(MaterialParams) == 32, "MaterialParams must match the std140 MaterialBlock entry");
+
+// `FrameBlock` in standard.vert/.frag (std140). Uploaded once per pass.
+struct FrameParams {
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::vec4 light_direction = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f);
+    glm::vec4 light_color = glm::vec4(1.0f);
+};
+static_assert(sizeof(FrameParams) == 160, "FrameParams must match the std140 FrameBlock");
 
 struct Material {
-    uint32_t shader_id;
+    uint32_t shader_id = 0;
     uint32_t texture_id = 0; // 0 means no texture
+    uint32_t render_state = MATERIAL_STATE_ALPHA_BLEND;
+    uint32_t block_index = 0; // entry in the MaterialBlock arena (u_materialIndex)
+    uint64_t sort_key = 0;
 };
 
 class MaterialManager {
 public:
+    // Must match the u_materials array size in standard.frag. 256 entries
+    // keep the block at 8 KiB, under the 16 KiB GL_MAX_UNIFORM_BLOCK_SIZE
+    // minimum.
+    static constexpr uint32_t MAX_MATERIALS = 256;
+
     MaterialManager();
     ~MaterialManager();
 
-    // Creates a material for a given shader and returns its ID.
-    uint32_t create_material(uint32_t shader_id);
+    // Creates a material for a given shader and returns its ID, or 0 once
+    // MAX_MATERIALS is reached.
+    uint32_t create_material(uint32_t shader_id, uint32_t render_state = MATERIAL_STATE_ALPHA_BLEND);
 
     // Sets the texture for a given material.
     void set_texture(uint32_t material_id, uint32_t texture_id);
 
+    void set_render_state(uint32_t material_id, uint32_t render_state);
+
+    // Replaces the material's parameter block; uploaded by upload_material_blocks().
+    void set_params(uint32_t material_id, const MaterialParams& params);
+
     // Returns a pointer to the material, allowing modification.
     Material* get_material(uint32_t material_id);
 
+    // Sort keys indexed by handle_index(material_id) (entry 0 unused), for
+    // sort_renderables_by_material_key().
+    const std::vector<uint64_t>& get_sort_keys() const { return m_sort_keys; }
+
+    // Uploads changed parameter blocks (a no-op on clean frames) and binds
+    // the arena to MATERIAL_BLOCK_BINDING.
+    void upload_material_blocks();
+
+    // Uploads per-pass data and binds it to FRAME_BLOCK_BINDING.
+    void upload_frame_params(const FrameParams& params);
+
 private:
-    uint32_t m_next_material_id;
-    std::unordered_map<uint32_t, Material> m_materials;
+    void refresh_sort_key(uint32_t material_id, Material& material);
+
+    HandlePool<Material> m_materials;
+    std::vector<uint64_t> m_sort_keys;
+    std::vector<MaterialParams> m_params;   // indexed by Material::block_index
+    bool m_params_dirty;
+    uint32_t m_material_ubo;
+    uint32_t m_frame_ubo;
 };
@@ -1,4 +1,5 @@
 #include "renderer/MeshManager.hpp"
+#include "profiler/Profiler.hpp"
 #include <glad/glad.h>
 #include <array>
 #include <cstddef>
@@ -310,16 +311,16 @@ GLMesh upload_mesh(
 }
 } // namespace
 
-MeshManager::MeshManager() : m_next_mesh_id(1) {}
+MeshManager::MeshManager() = default;
 
 MeshManager::~MeshManager() {
-    for (auto const& [id, mesh] : m_meshes) {
+    m_meshes.for_each([](uint32_t, const GLMesh& mesh) {
         glDeleteVertexArrays(1, &mesh.vao);
         glDeleteBuffers(1, &mesh.vbo);
         if (mesh.ebo != 0) {
             glDeleteBuffers(1, &mesh.ebo);
         }
-    }
+    });
 }
 
 uint32_t MeshManager::create_quad_mesh() {
@@ -335,18 +336,16 @@ uint32_t MeshManager::create_quad_mesh() {
     };
 
     GLMesh mesh = upload_mesh(vertices, indices);
-    uint32_t mesh_id = m_next_mesh_id++;
-    m_meshes[mesh_id] = mesh;
-
-    return mesh_id;
+    return m_meshes.insert(mesh);
 }
 
 uint32_t MeshManager::load_obj_mesh(uint32_t mesh_id, const std::string& path) {
-    if (m_meshes.find(mesh_id) != m_meshes.end()) {
+    if (mesh_id == 0 || m_meshes.get(mesh_id) != nullptr) {
         std::cerr << "MeshManager::load_obj_mesh - Mesh ID " << mesh_id
                   << " already registered." << std::endl;
         return 0;
     }
+    MIYABI_PROFILE_SCOPE("MeshLoad");
 
     std::vector<float> vertices;
     std::vector<unsigned int> indices;
@@ -354,14 +353,59 @@ uint32_t MeshManager::load_obj_mesh(uint32_t mesh_id, const std::string& path) {
         return 0;
     }
 
-    m_meshes[mesh_id] = upload_mesh(vertices, indices);
-    return mesh_id;
+    const uint32_t registered_id = m_meshes.insert_at(mesh_id, upload_mesh(vertices, indices));
+    if (registered_id != 0) {
+        m_mesh_paths[registered_id] = path;
+    }
+    return registered_id;
+}
+
+uint32_t MeshManager::reload_obj_mesh_file(const std::string& path) {
+    const fs::path changed = fs::path(path).lexically_normal();
+    uint32_t reloaded = 0;
+    for (const auto& [mesh_id, mesh_path] : m_mesh_paths) {
+        if (fs::path(mesh_path).lexically_normal() != changed) {
+            continue;
+        }
+        GLMesh* mesh = m_meshes.get(mesh_id);
+        if (!mesh) {
+            continue;
+        }
+
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        if (!build_mesh_from_obj(mesh_path, vertices, indices)) {
+            std::cerr << "MeshManager::reload_obj_mesh_file - keeping previous data for mesh ID "
+                      << mesh_id << std::endl;
+            continue;
+        }
+
+        // Same buffer objects, new storage: attribute bindings are untouched.
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            static_cast<GLsizeiptr>(vertices.size() * sizeof(float)),
+            vertices.data(),
+            GL_STATIC_DRAW
+        );
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(mesh->vao);
+        glBufferData(
+            GL_ELEMENT_ARRAY_BUFFER,
+            static_cast<GLsizeiptr>(indices.size() * sizeof(unsigned int)),
+            indices.data(),
+            GL_STATIC_DRAW
+        );
+        glBindVertexArray(0);
+        mesh->element_count = static_cast<uint32_t>(indices.size());
+        ++reloaded;
+    }
+    return reloaded;
 }
 
 void MeshManager::bind_mesh(uint32_t mesh_id) const {
-    auto it = m_meshes.find(mesh_id);
-    if (it != m_meshes.end()) {
-        glBindVertexArray(it->second.vao);
+    if (const GLMesh* mesh = m_meshes.get(mesh_id)) {
+        glBindVertexArray(mesh->vao);
     } else {
         std::cerr << "MeshManager::bind_mesh - Mesh ID " << mesh_id << " not found." << std::endl;
         glBindVertexArray(0);
@@ -369,9 +413,5 @@ void MeshManager::bind_mesh(uint32_t mesh_id) const {
 }
 
 const GLMesh* MeshManager::get_mesh(uint32_t mesh_id) const {
-    auto it = m_meshes.find(mesh_id);
-    if (it != m_meshes.end()) {
-        return &it->second;
-    }
-    return nullptr;
+    return m_meshes.get(mesh_id);
 }
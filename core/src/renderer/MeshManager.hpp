@@ -4,11 +4,13 @@
 #include <string>
 #include <unordered_map>
 
+#include "renderer/HandlePool.hpp"
+
 struct GLMesh {
-    uint32_t vao;
-    uint32_t vbo;
-    uint32_t ebo; // Element Buffer Object
-    uint32_t element_count;
+    uint32_t vao = 0;
+    uint32_t vbo = 0;
+    uint32_t ebo = 0; // Element Buffer Object
+    uint32_t element_count = 0;
 };
 
 class MeshManager {
@@ -19,15 +21,21 @@ public:
     // Creates a quad mesh with texture coordinates and returns its ID.
     uint32_t create_quad_mesh();
 
-    // Loads a Wavefront OBJ mesh into an explicit registry slot.
+    // Loads a Wavefront OBJ mesh into an explicit registry slot, returning
+    // that id, or 0 if the slot is taken or the file cannot be parsed.
     uint32_t load_obj_mesh(uint32_t mesh_id, const std::string& path);
 
+    // Re-reads every mesh loaded from `path` into its existing buffers, so
+    // ids and VAO state (including instance attributes) stay valid.
+    // Returns the number of meshes updated.
+    uint32_t reload_obj_mesh_file(const std::string& path);
+
     // Binds the VAO for the given mesh ID for drawing.
     void bind_mesh(uint32_t mesh_id) const;
 
     const GLMesh* get_mesh(uint32_t mesh_id) const;
 
 private:
-    uint32_t m_next_mesh_id;
-    std::unordered_map<uint32_t, GLMesh> m_meshes;
+    HandlePool<GLMesh> m_meshes;
+    std::unordered_map<uint32_t, std::string> m_mesh_paths; // hot reload only
 };
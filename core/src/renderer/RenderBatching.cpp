@@ -1,6 +1,19 @@
 #include "renderer/RenderBatching.hpp"
+#include "renderer/HandlePool.hpp"
 
 #include <algorithm>
+#include <limits>
+
+uint64_t make_material_sort_key(
+    uint32_t render_state,
+    uint32_t shader_id,
+    uint32_t texture_id,
+    uint32_t material_id) {
+    return (static_cast<uint64_t>(render_state & 0xFFu) << 56)
+        | (static_cast<uint64_t>(shader_id & 0xFFFFu) << 40)
+        | (static_cast<uint64_t>(texture_id & 0xFFFFu) << 24)
+        | static_cast<uint64_t>(material_id & 0xFFFFFFu);
+}
 
 void sort_renderables_for_batching(std::vector<RenderableObject>& renderables) {
     std::sort(
@@ -14,6 +27,34 @@ void sort_renderables_for_batching(std::vector<RenderableObject>& renderables) {
         });
 }
 
+void sort_renderables_by_material_key(
+    std::vector<RenderableObject>& renderables,
+    const std::vector<uint64_t>& material_sort_keys) {
+    const auto key_of = [&material_sort_keys](uint32_t material_id) {
+        const uint32_t slot = handle_index(material_id);
+        return slot < material_sort_keys.size()
+            ? material_sort_keys[slot]
+            : std::numeric_limits<uint64_t>::max();
+    };
+    std::sort(
+        renderables.begin(),
+        renderables.end(),
+        [&key_of](const RenderableObject& lhs, const RenderableObject& rhs) {
+            const uint64_t lhs_key = key_of(lhs.material_id);
+            const uint64_t rhs_key = key_of(rhs.material_id);
+            if (lhs_key != rhs_key) {
+                return lhs_key < rhs_key;
+            }
+            if (lhs.material_id != rhs.material_id) {
+                return lhs.material_id < rhs.material_id;
+            }
+            if (lhs.mesh_id != rhs.mesh_id) {
+                return lhs.mesh_id < rhs.mesh_id;
+            }
+            return lhs.texture_id < rhs.texture_id;
+        });
+}
+
 std::vector<MaterialMeshBatch> build_material_mesh_batches(
     const std::vector<RenderableObject>& sorted_renderables) {
     std::vector<MaterialMeshBatch> batches;
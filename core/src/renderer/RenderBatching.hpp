@@ -13,6 +13,24 @@ struct MaterialMeshBatch {
     size_t instance_count;
 };
 
+// Orders materials by what a switch between them costs, most expensive
+// first: render state (8 bits), shader (16), texture (16), then material id
+// (24) so that equal keys never interleave two materials. Wider values are
+// truncated.
+uint64_t make_material_sort_key(
+    uint32_t render_state,
+    uint32_t shader_id,
+    uint32_t texture_id,
+    uint32_t material_id);
+
 void sort_renderables_for_batching(std::vector<RenderableObject>& renderables);
+
+// Sorts by the material's entry in `material_sort_keys`, indexed by handle
+// slot (see MaterialManager::get_sort_keys), then mesh, then texture so that
+// each batch holds contiguous texture runs. Materials outside the table sort
+// last.
+void sort_renderables_by_material_key(
+    std::vector<RenderableObject>& renderables,
+    const std::vector<uint64_t>& material_sort_keys);
 std::vector<MaterialMeshBatch> build_material_mesh_batches(
     const std::vector<RenderableObject>& sorted_renderables);
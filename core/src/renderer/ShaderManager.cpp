@@ -5,10 +5,71 @@
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#include <chrono>
 
 namespace {
 namespace fs = std::filesystem;
 
+// ARB_get_program_binary (core in 4.1) is not generated into our 3.3 glad.
+constexpr GLenum GL_PROGRAM_BINARY_RETRIEVABLE_HINT_VALUE = 0x8257;
+constexpr GLenum GL_PROGRAM_BINARY_LENGTH_VALUE = 0x8741;
+constexpr GLenum GL_NUM_PROGRAM_BINARY_FORMATS_VALUE = 0x87FE;
+typedef void (APIENTRYP PFN_GetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+typedef void (APIENTRYP PFN_ProgramBinary)(GLuint, GLenum, const void*, GLsizei);
+typedef void (APIENTRYP PFN_ProgramParameteri)(GLuint, GLenum, GLint);
+
+// KHR_parallel_shader_compile; the ARB variant shares the enum value.
+constexpr GLenum GL_COMPLETION_STATUS_KHR_VALUE = 0x91B1;
+constexpr GLuint MAX_SHADER_COMPILER_THREADS_DRIVER_DEFAULT = 0xFFFFFFFFu;
+typedef void (APIENTRYP PFN_MaxShaderCompilerThreads)(GLuint);
+
+// On-disk layout: header followed by `length` bytes of driver binary.
+constexpr uint32_t PROGRAM_CACHE_MAGIC = 0x4250594D; // "MYPB"
+constexpr uint32_t PROGRAM_CACHE_VERSION = 1;
+constexpr uint32_t PROGRAM_CACHE_MAX_BYTES = 16u * 1024u * 1024u;
+
+struct ProgramCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t binary_format;
+    uint32_t length;
+};
+
+constexpr uint64_t FNV_OFFSET_BASIS = 1469598103934665603ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+// Hashes the bytes plus a terminator so ("ab","c") and ("a","bc") differ.
+uint64_t fnv1a_field(uint64_t hash, const std::string& field) {
+    for (const unsigned char byte : field) {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    }
+    hash ^= 0xFFu;
+    hash *= FNV_PRIME;
+    return hash;
+}
+
+bool has_gl_extension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const GLubyte* extension = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i));
+        if (extension && std::string(reinterpret_cast<const char*>(extension)) == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string gl_string(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
 std::string summarize_gl_errors() {
     std::ostringstream oss;
     bool has_error = false;
@@ -41,15 +102,85 @@ std::string resolve_shader_path(const std::string& requested_path) {
 }
 }
 
-ShaderManager::ShaderManager() : m_next_shader_id(1) {}
+ShaderManager::ShaderManager()
+    : m_parallel_compile(false),
+      m_get_program_binary(nullptr),
+      m_program_binary(nullptr),
+      m_program_parameteri(nullptr) {}
 
 ShaderManager::~ShaderManager() {
-    for (auto const& [shader_id, program_id] : m_shader_id_to_program_id) {
-        glDeleteProgram(program_id);
+    m_programs.for_each([](uint32_t, const uint32_t& program_id) {
+        if (program_id != 0) {
+            glDeleteProgram(program_id);
+        }
+    });
+    for (auto const& [shader_id, pending] : m_pending) {
+        glDeleteShader(pending.vertex_shader);
+        glDeleteShader(pending.fragment_shader);
+        glDeleteProgram(pending.program);
     }
 }
 
-uint32_t ShaderManager::load_shader(const std::string& vertex_path, const std::string& fragment_path) {
+bool ShaderManager::enable_parallel_compile(ProcLoader loader) {
+    const bool khr = has_gl_extension("GL_KHR_parallel_shader_compile");
+    const bool arb = !khr && has_gl_extension("GL_ARB_parallel_shader_compile");
+    if (!khr && !arb) {
+        std::cout << "[renderer.shader] parallel compile unavailable: serial builds" << std::endl;
+        return false;
+    }
+
+    // Let the driver pick its thread count; some default to zero threads.
+    if (loader) {
+        void* max_threads = loader(khr ? "glMaxShaderCompilerThreadsKHR" : "glMaxShaderCompilerThreadsARB");
+        if (max_threads) {
+            reinterpret_cast<PFN_MaxShaderCompilerThreads>(max_threads)(MAX_SHADER_COMPILER_THREADS_DRIVER_DEFAULT);
+        }
+    }
+    m_parallel_compile = true;
+    std::cout << "[renderer.shader] parallel compile enabled ext="
+              << (khr ? "KHR" : "ARB") << "_parallel_shader_compile" << std::endl;
+    return true;
+}
+
+bool ShaderManager::enable_program_cache(const std::string& cache_dir, ProcLoader loader) {
+    if (!loader) {
+        return false;
+    }
+    GLint format_count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_VALUE, &format_count);
+    glGetError(); // GL_INVALID_ENUM on contexts without the extension.
+
+    void* get_program_binary = loader("glGetProgramBinary");
+    void* program_binary = loader("glProgramBinary");
+    void* program_parameteri = loader("glProgramParameteri");
+    if (format_count <= 0 || !get_program_binary || !program_binary || !program_parameteri) {
+        std::cout << "[renderer.shader] program cache unavailable: driver exposes no program binary formats" << std::endl;
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(cache_dir, ec);
+    if (ec) {
+        std::cerr
+            << "Warning::ShaderManager: program cache disabled, cannot create directory"
+            << " path=\"" << cache_dir << "\""
+            << " reason=\"" << ec.message() << "\""
+            << std::endl;
+        return false;
+    }
+
+    m_get_program_binary = get_program_binary;
+    m_program_binary = program_binary;
+    m_program_parameteri = program_parameteri;
+    m_driver_fingerprint =
+        gl_string(GL_VENDOR) + "\n" + gl_string(GL_RENDERER) + "\n" + gl_string(GL_VERSION);
+    m_cache_dir = cache_dir;
+    std::cout << "[renderer.shader] program cache enabled dir=" << cache_dir
+              << " formats=" << format_count << std::endl;
+    return true;
+}
+
+uint32_t ShaderManager::request_shader(const std::string& vertex_path, const std::string& fragment_path) {
     std::string vertex_source = read_file(vertex_path);
     std::string fragment_source = read_file(fragment_path);
 
@@ -63,32 +194,386 @@ uint32_t ShaderManager::load_shader(const std::string& vertex_path, const std::s
         return 0;
     }
 
-    uint32_t vertex_shader = compile_shader(GL_VERTEX_SHADER, vertex_source, vertex_path);
-    if (vertex_shader == 0) {
+    const uint32_t shader_id = request_program(vertex_source, fragment_source, "", vertex_path, fragment_path);
+    if (shader_id != 0) {
+        m_program_sources[shader_id] = { vertex_path, fragment_path, SHADER_FEATURE_NONE };
+    }
+    return shader_id;
+}
+
+uint32_t ShaderManager::request_permutation(
+    const std::string& vertex_path,
+    const std::string& fragment_path,
+    uint32_t features
+) {
+    if ((features & ~SHADER_FEATURE_ALL) != 0) {
+        std::cerr
+            << "ERROR::SHADER::PERMUTATION::UNKNOWN_FEATURES"
+            << " vertex_path=\"" << vertex_path << "\""
+            << " features=0x" << std::hex << features << std::dec
+            << std::endl;
         return 0;
     }
 
-    uint32_t fragment_shader = compile_shader(GL_FRAGMENT_SHADER, fragment_source, fragment_path);
-    if (fragment_shader == 0) {
-        glDeleteShader(vertex_shader);
+    const std::string key = vertex_path + "\n" + fragment_path + "\n" + std::to_string(features);
+    auto it = m_permutations.find(key);
+    if (it != m_permutations.end()) {
+        return it->second;
+    }
+
+    const std::string vertex_source = read_file(vertex_path);
+    const std::string fragment_source = read_file(fragment_path);
+    if (vertex_source.empty() || fragment_source.empty()) {
+        std::cerr
+            << "ERROR::SHADER::LOAD::READ_FAILED"
+            << " vertex_path=\"" << vertex_path << "\""
+            << " fragment_path=\"" << fragment_path << "\""
+            << " gl_errors=" << summarize_gl_errors()
+            << std::endl;
         return 0;
     }
 
-    uint32_t program_id = create_program(vertex_shader, fragment_shader, vertex_path, fragment_path);
+    const std::string defines = build_shader_feature_defines(features);
+    const uint32_t shader_id = request_program(
+        inject_shader_defines(vertex_source, defines),
+        inject_shader_defines(fragment_source, defines),
+        defines,
+        vertex_path,
+        fragment_path
+    );
+    if (shader_id != 0) {
+        m_permutations.emplace(key, shader_id);
+        m_program_sources[shader_id] = { vertex_path, fragment_path, features };
+    }
+    return shader_id;
+}
+
+uint32_t ShaderManager::reload_shader_file(const std::string& path) {
+    const fs::path changed = fs::path(path).lexically_normal();
+    uint32_t rebuilt = 0;
+    for (const auto& [shader_id, source] : m_program_sources) {
+        if (fs::path(source.vertex_path).lexically_normal() != changed &&
+            fs::path(source.fragment_path).lexically_normal() != changed) {
+            continue;
+        }
+        if (m_pending.count(shader_id) != 0) {
+            continue; // The original build has not finished yet.
+        }
+        if (rebuild_program(shader_id, source)) {
+            ++rebuilt;
+        }
+    }
+    return rebuilt;
+}
+
+bool ShaderManager::rebuild_program(uint32_t shader_id, const ProgramSource& source) {
+    const std::string vertex_source = read_file(source.vertex_path);
+    const std::string fragment_source = read_file(source.fragment_path);
+    if (vertex_source.empty() || fragment_source.empty()) {
+        return false;
+    }
+
+    const std::string defines = build_shader_feature_defines(source.features);
+    const std::string vertex_variant = inject_shader_defines(vertex_source, defines);
+    const std::string fragment_variant = inject_shader_defines(fragment_source, defines);
+
+    // Reloads block: they are rare and the new program is wanted right away.
+    std::string cache_path;
+    uint32_t program_id = 0;
+    if (!m_cache_dir.empty()) {
+        cache_path = program_cache_path(vertex_variant, fragment_variant, defines);
+        program_id = load_cached_program(cache_path);
+    }
     if (program_id == 0) {
-        return 0;
+        const uint32_t vertex_shader = submit_shader(GL_VERTEX_SHADER, vertex_variant);
+        const uint32_t fragment_shader = submit_shader(GL_FRAGMENT_SHADER, fragment_variant);
+        PendingProgram pending = {
+            submit_program(vertex_shader, fragment_shader),
+            vertex_shader,
+            fragment_shader,
+            source.vertex_path,
+            source.fragment_path,
+            cache_path,
+            std::chrono::steady_clock::now()
+        };
+        program_id = finish_program(pending);
+    }
+    if (program_id == 0) {
+        std::cerr << "ShaderManager::reload_shader_file - keeping previous program for shader_id "
+                  << shader_id << std::endl;
+        return false;
     }
 
-    uint32_t shader_id = m_next_shader_id++;
-    m_shader_id_to_program_id[shader_id] = program_id;
+    uint32_t* slot = m_programs.get(shader_id);
+    if (!slot) {
+        glDeleteProgram(program_id);
+        return false;
+    }
+    if (*slot != 0) {
+        glDeleteProgram(*slot);
+    }
+    // Also revives a program whose first build failed.
+    *slot = program_id;
+    return true;
+}
 
+uint32_t ShaderManager::load_shader(const std::string& vertex_path, const std::string& fragment_path) {
+    const uint32_t shader_id = request_shader(vertex_path, fragment_path);
+    auto it = m_pending.find(shader_id);
+    if (it != m_pending.end()) {
+        // Querying the link status blocks until the driver is done.
+        resolve_pending(shader_id, it->second);
+        m_pending.erase(it);
+        if (get_status(shader_id) != ShaderStatus::Ready) {
+            return 0;
+        }
+    }
     return shader_id;
 }
 
+void ShaderManager::poll_pending() {
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(it->second.program, GL_COMPLETION_STATUS_KHR_VALUE, &completed);
+        if (completed == GL_FALSE) {
+            ++it;
+            continue;
+        }
+        resolve_pending(it->first, it->second);
+        it = m_pending.erase(it);
+    }
+}
+
+ShaderStatus ShaderManager::get_status(uint32_t shader_id) const {
+    if (m_pending.count(shader_id) != 0) {
+        return ShaderStatus::Pending;
+    }
+    const uint32_t* program_id = m_programs.get(shader_id);
+    return program_id && *program_id != 0 ? ShaderStatus::Ready : ShaderStatus::Failed;
+}
+
+uint32_t ShaderManager::request_program(
+    const std::string& vertex_source,
+    const std::string& fragment_source,
+    const std::string& defines,
+    const std::string& vertex_path,
+    const std::string& fragment_path
+) {
+    const auto start = std::chrono::steady_clock::now();
+    std::string cache_path;
+    if (!m_cache_dir.empty()) {
+        cache_path = program_cache_path(vertex_source, fragment_source, defines);
+        const uint32_t cached_program = load_cached_program(cache_path);
+        if (cached_program != 0) {
+            ++m_load_stats.cache_hits;
+            ++m_load_stats.programs;
+            m_load_stats.load_ms += elapsed_ms(start);
+            return m_programs.insert(cached_program);
+        }
+        ++m_load_stats.cache_misses;
+    }
+
+    // Submit everything without querying status: with parallel compile the
+    // driver works on it in the background until the first status query.
+    const uint32_t vertex_shader = submit_shader(GL_VERTEX_SHADER, vertex_source);
+    const uint32_t fragment_shader = submit_shader(GL_FRAGMENT_SHADER, fragment_source);
+    PendingProgram pending = {
+        submit_program(vertex_shader, fragment_shader),
+        vertex_shader,
+        fragment_shader,
+        vertex_path,
+        fragment_path,
+        cache_path,
+        start
+    };
+
+    if (m_parallel_compile) {
+        // The slot holds 0 until resolve_pending() fills it in.
+        const uint32_t shader_id = m_programs.insert(0);
+        m_pending.emplace(shader_id, std::move(pending));
+        ++m_load_stats.parallel_submits;
+        return shader_id;
+    }
+
+    const uint32_t program_id = finish_program(pending);
+    if (program_id == 0) {
+        return 0;
+    }
+    return m_programs.insert(program_id);
+}
+
+uint32_t ShaderManager::finish_program(PendingProgram& pending) {
+    const bool vertex_ok = check_compile_status(pending.vertex_shader, GL_VERTEX_SHADER, pending.vertex_path);
+    const bool fragment_ok = check_compile_status(pending.fragment_shader, GL_FRAGMENT_SHADER, pending.fragment_path);
+    const bool linked = vertex_ok && fragment_ok
+        && check_link_status(pending.program, pending.vertex_path, pending.fragment_path);
+
+    // Attached shaders are only flagged here and go away with the program.
+    glDeleteShader(pending.vertex_shader);
+    glDeleteShader(pending.fragment_shader);
+    m_load_stats.load_ms += elapsed_ms(pending.start);
+
+    if (!linked) {
+        glDeleteProgram(pending.program);
+        return 0;
+    }
+    apply_uniform_block_bindings(pending.program);
+    if (!pending.cache_path.empty()) {
+        store_cached_program(pending.program, pending.cache_path);
+    }
+    ++m_load_stats.programs;
+    return pending.program;
+}
+
+void ShaderManager::resolve_pending(uint32_t shader_id, PendingProgram& pending) {
+    const uint32_t program_id = finish_program(pending);
+    if (uint32_t* slot = m_programs.get(shader_id)) {
+        *slot = program_id;
+    } else if (program_id != 0) {
+        glDeleteProgram(program_id);
+    }
+}
+
+std::string ShaderManager::program_cache_path(
+    const std::string& vertex_source,
+    const std::string& fragment_source,
+    const std::string& defines
+) const {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    hash = fnv1a_field(hash, vertex_source);
+    hash = fnv1a_field(hash, fragment_source);
+    hash = fnv1a_field(hash, defines);
+    hash = fnv1a_field(hash, m_driver_fingerprint);
+
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+    return (fs::path(m_cache_dir) / name.str()).string();
+}
+
+uint32_t ShaderManager::load_cached_program(const std::string& cache_path) {
+    std::ifstream file(cache_path, std::ios::binary);
+    if (!file) {
+        return 0;
+    }
+
+    ProgramCacheHeader header{};
+    std::vector<char> blob;
+    bool valid = static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        && header.magic == PROGRAM_CACHE_MAGIC
+        && header.version == PROGRAM_CACHE_VERSION
+        && header.length > 0
+        && header.length <= PROGRAM_CACHE_MAX_BYTES;
+    if (valid) {
+        blob.resize(header.length);
+        valid = static_cast<bool>(file.read(blob.data(), static_cast<std::streamsize>(blob.size())));
+    }
+    file.close();
+
+    uint32_t program = 0;
+    if (valid) {
+        program = glCreateProgram();
+        reinterpret_cast<PFN_ProgramBinary>(m_program_binary)(
+            program, header.binary_format, blob.data(), static_cast<GLsizei>(blob.size()));
+        int success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            glDeleteProgram(program);
+            program = 0;
+        } else {
+            apply_uniform_block_bindings(program);
+        }
+    }
+
+    if (program == 0) {
+        // Truncated file or a binary the driver no longer accepts (e.g. after
+        // a driver update): drop it so the recompiled program replaces it.
+        std::cerr
+            << "Warning::ShaderManager: discarding stale program cache entry"
+            << " path=\"" << cache_path << "\""
+            << " gl_errors=" << summarize_gl_errors()
+            << std::endl;
+        std::error_code ec;
+        fs::remove(cache_path, ec);
+    }
+    return program;
+}
+
+void ShaderManager::store_cached_program(uint32_t program_id, const std::string& cache_path) {
+    GLint length = 0;
+    glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH_VALUE, &length);
+    if (length <= 0 || static_cast<uint32_t>(length) > PROGRAM_CACHE_MAX_BYTES) {
+        return;
+    }
+
+    std::vector<char> blob(static_cast<size_t>(length));
+    GLsizei written = 0;
+    GLenum binary_format = 0;
+    reinterpret_cast<PFN_GetProgramBinary>(m_get_program_binary)(
+        program_id, length, &written, &binary_format, blob.data());
+    if (written <= 0) {
+        return;
+    }
+
+    const ProgramCacheHeader header = {
+        PROGRAM_CACHE_MAGIC,
+        PROGRAM_CACHE_VERSION,
+        binary_format,
+        static_cast<uint32_t>(written)
+    };
+
+    // Write then rename so a crash mid-write never leaves a torn entry.
+    const std::string temp_path = cache_path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(blob.data(), written);
+        if (!file) {
+            std::cerr << "Warning::ShaderManager: failed to write program cache entry path=\""
+                      << temp_path << "\"" << std::endl;
+            return;
+        }
+    }
+    std::error_code ec;
+    fs::rename(temp_path, cache_path, ec);
+    if (ec) {
+        fs::remove(temp_path, ec);
+        return;
+    }
+    ++m_load_stats.cache_stores;
+}
+
+void ShaderManager::set_uniform_block_binding(const std::string& block_name, uint32_t binding) {
+    bool found = false;
+    for (auto& [name, existing_binding] : m_uniform_block_bindings) {
+        if (name == block_name) {
+            existing_binding = binding;
+            found = true;
+        }
+    }
+    if (!found) {
+        m_uniform_block_bindings.emplace_back(block_name, binding);
+    }
+    m_programs.for_each([this](uint32_t, const uint32_t& program_id) {
+        if (program_id != 0) {
+            apply_uniform_block_bindings(program_id);
+        }
+    });
+}
+
+void ShaderManager::apply_uniform_block_bindings(uint32_t program_id) const {
+    // GLSL 330 has no layout(binding = N), so blocks are bound by name here.
+    for (const auto& [name, binding] : m_uniform_block_bindings) {
+        const GLuint block_index = glGetUniformBlockIndex(program_id, name.c_str());
+        if (block_index != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program_id, block_index, binding);
+        }
+    }
+}
+
 void ShaderManager::use_shader(uint32_t shader_id) const {
-    auto it = m_shader_id_to_program_id.find(shader_id);
-    if (it != m_shader_id_to_program_id.end()) {
-        glUseProgram(it->second);
+    const uint32_t program_id = get_program_id(shader_id);
+    if (program_id != 0) {
+        glUseProgram(program_id);
     } else {
         std::cerr << "ShaderManager::use_shader - Shader ID " << shader_id << " not found." << std::endl;
         glUseProgram(0);
@@ -96,11 +581,8 @@ void ShaderManager::use_shader(uint32_t shader_id) const {
 }
 
 uint32_t ShaderManager::get_program_id(uint32_t shader_id) const {
-    auto it = m_shader_id_to_program_id.find(shader_id);
-    if (it != m_shader_id_to_program_id.end()) {
-        return it->second;
-    }
-    return 0;
+    const uint32_t* program_id = m_programs.get(shader_id);
+    return program_id ? *program_id : 0;
 }
 
 std::string ShaderManager::read_file(const std::string& file_path) {
@@ -124,12 +606,27 @@ std::string ShaderManager::read_file(const std::string& file_path) {
     return stream.str();
 }
 
-uint32_t ShaderManager::compile_shader(uint32_t type, const std::string& source, const std::string& source_path) {
+uint32_t ShaderManager::submit_shader(uint32_t type, const std::string& source) {
     uint32_t shader = glCreateShader(type);
     const char* src = source.c_str();
     glShaderSource(shader, 1, &src, nullptr);
     glCompileShader(shader);
+    return shader;
+}
 
+uint32_t ShaderManager::submit_program(uint32_t vertex_shader, uint32_t fragment_shader) {
+    uint32_t program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+    if (m_program_parameteri) {
+        reinterpret_cast<PFN_ProgramParameteri>(m_program_parameteri)(
+            program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT_VALUE, GL_TRUE);
+    }
+    glLinkProgram(program);
+    return program;
+}
+
+bool ShaderManager::check_compile_status(uint32_t shader, uint32_t type, const std::string& source_path) {
     int success;
     char infoLog[512];
     glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
@@ -143,24 +640,16 @@ uint32_t ShaderManager::compile_shader(uint32_t type, const std::string& source,
             << " gl_errors=" << summarize_gl_errors()
             << "\n" << infoLog
             << std::endl;
-        glDeleteShader(shader);
-        return 0;
+        return false;
     }
-
-    return shader;
+    return true;
 }
 
-uint32_t ShaderManager::create_program(
-    uint32_t vertex_shader,
-    uint32_t fragment_shader,
+bool ShaderManager::check_link_status(
+    uint32_t program,
     const std::string& vertex_path,
     const std::string& fragment_path
 ) {
-    uint32_t program = glCreateProgram();
-    glAttachShader(program, vertex_shader);
-    glAttachShader(program, fragment_shader);
-    glLinkProgram(program);
-
     int success;
     char infoLog[512];
     glGetProgramiv(program, GL_LINK_STATUS, &success);
@@ -173,12 +662,7 @@ uint32_t ShaderManager::create_program(
             << " gl_errors=" << summarize_gl_errors()
             << "\n" << infoLog
             << std::endl;
-        glDeleteProgram(program);
-        program = 0;
+        return false;
     }
-
-    glDeleteShader(vertex_shader);
-    glDeleteShader(fragment_shader);
-
-    return program;
+    return true;
 }
@@ -2,35 +2,155 @@
 
 #include <string>
 #include <vector>
+#include <utility>
 #include <cstdint>
 #include <unordered_map>
+#include <chrono>
+
+#include "renderer/HandlePool.hpp"
+#include "renderer/ShaderPermutation.hpp"
+
+// Build state of a requested shader program.
+enum class ShaderStatus {
+    Pending,    // Compile/link submitted; the driver is still working on it.
+    Ready,
+    Failed,     // Unknown ids report Failed as well.
+};
+
+// Startup counters for ShaderManager program builds.
+struct ShaderLoadStats {
+    uint32_t programs = 0;
+    uint32_t cache_hits = 0;
+    uint32_t cache_misses = 0;
+    uint32_t cache_stores = 0;
+    uint32_t parallel_submits = 0;
+    double load_ms = 0.0;       // Sum of per-program submit-to-ready time.
+};
 
 class ShaderManager {
 public:
+    // Same signature as GLADloadproc / glfwGetProcAddress.
+    using ProcLoader = void* (*)(const char* name);
+
     ShaderManager();
     ~ShaderManager();
 
-    // Loads a shader program from vertex and fragment shader files.
-    // Returns a shader_id, or 0 if loading fails.
+    // Enables the on-disk program binary cache in `cache_dir`. The
+    // ARB_get_program_binary entry points are not part of our GL 3.3 loader,
+    // so they are resolved through `loader`. Returns false (cache stays off,
+    // shaders are compiled as before) when the driver exposes no binary
+    // formats or the directory cannot be created.
+    bool enable_program_cache(const std::string& cache_dir, ProcLoader loader);
+
+    // Turns on non-blocking builds when KHR/ARB_parallel_shader_compile is
+    // available, letting the driver compile on its own threads. Returns false
+    // (request_shader stays serial) when the extension is missing.
+    bool enable_parallel_compile(ProcLoader loader);
+
+    // Submits compile and link of a program and returns its shader_id
+    // without waiting. With parallel compile the id stays Pending until
+    // poll_pending() sees the driver finish; otherwise the build happens
+    // here and 0 is returned on failure. Also returns 0 if a file is missing.
+    uint32_t request_shader(const std::string& vertex_path, const std::string& fragment_path);
+
+    // Returns the variant of an uber-shader pair for a ShaderFeature mask,
+    // requesting it (see request_shader) the first time that combination is
+    // asked for and returning the same shader_id afterwards. Returns 0 for
+    // unknown feature bits or unreadable files.
+    uint32_t request_permutation(
+        const std::string& vertex_path,
+        const std::string& fragment_path,
+        uint32_t features
+    );
+
+    // Loads a shader program from vertex and fragment shader files, waiting
+    // for the build to finish. Returns a shader_id, or 0 if loading fails.
     uint32_t load_shader(const std::string& vertex_path, const std::string& fragment_path);
 
+    // Promotes every pending program whose build has completed to Ready or
+    // Failed. Cheap when nothing is pending; call once per frame.
+    void poll_pending();
+
+    // Rebuilds every program built from `path` (vertex or fragment stage),
+    // keeping its shader_id. A program that fails to rebuild keeps its
+    // previous binary. Returns the number of programs replaced.
+    uint32_t reload_shader_file(const std::string& path);
+
+    ShaderStatus get_status(uint32_t shader_id) const;
+    size_t pending_count() const { return m_pending.size(); }
+
+    // Binds the uniform block `block_name` to `binding` in every program
+    // that declares it, now and whenever a program is built or reloaded.
+    void set_uniform_block_binding(const std::string& block_name, uint32_t binding);
+
     // Uses the specified shader program.
     void use_shader(uint32_t shader_id) const;
 
     // Gets the OpenGL program ID from a shader_id.
-    // Returns 0 if not found.
+    // Returns 0 if not found or not Ready yet.
     uint32_t get_program_id(uint32_t shader_id) const;
 
+    const ShaderLoadStats& get_load_stats() const { return m_load_stats; }
+
 private:
-    std::string read_file(const std::string& file_path);
-    uint32_t compile_shader(uint32_t type, const std::string& source, const std::string& source_path);
-    uint32_t create_program(
-        uint32_t vertex_shader,
-        uint32_t fragment_shader,
+    // Compile and link submitted to the driver but not yet checked.
+    struct PendingProgram {
+        uint32_t program;
+        uint32_t vertex_shader;
+        uint32_t fragment_shader;
+        std::string vertex_path;
+        std::string fragment_path;
+        std::string cache_path;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // What a shader_id was built from, for hot reload.
+    struct ProgramSource {
+        std::string vertex_path;
+        std::string fragment_path;
+        uint32_t features;
+    };
+
+    bool rebuild_program(uint32_t shader_id, const ProgramSource& source);
+    uint32_t request_program(
+        const std::string& vertex_source,
+        const std::string& fragment_source,
+        const std::string& defines,
         const std::string& vertex_path,
         const std::string& fragment_path
     );
+    // Checks build status, stores the binary and returns the program, or 0.
+    uint32_t finish_program(PendingProgram& pending);
+    void resolve_pending(uint32_t shader_id, PendingProgram& pending);
+    std::string program_cache_path(
+        const std::string& vertex_source,
+        const std::string& fragment_source,
+        const std::string& defines
+    ) const;
+    uint32_t load_cached_program(const std::string& cache_path);
+    void store_cached_program(uint32_t program_id, const std::string& cache_path);
+
+    void apply_uniform_block_bindings(uint32_t program_id) const;
+    std::string read_file(const std::string& file_path);
+    uint32_t submit_shader(uint32_t type, const std::string& source);
+    uint32_t submit_program(uint32_t vertex_shader, uint32_t fragment_shader);
+    bool check_compile_status(uint32_t shader, uint32_t type, const std::string& source_path);
+    bool check_link_status(uint32_t program, const std::string& vertex_path, const std::string& fragment_path);
+
+    // shader_id -> GL program; 0 while Pending or after a failed build.
+    HandlePool<uint32_t> m_programs;
+    std::unordered_map<uint32_t, PendingProgram> m_pending;
+    // "vertex_path\nfragment_path\nfeatures" -> shader_id
+    std::unordered_map<std::string, uint32_t> m_permutations;
+    std::unordered_map<uint32_t, ProgramSource> m_program_sources;
+    std::vector<std::pair<std::string, uint32_t>> m_uniform_block_bindings;
+    bool m_parallel_compile;
 
-    uint32_t m_next_shader_id;
-    std::unordered_map<uint32_t, uint32_t> m_shader_id_to_program_id;
+    std::string m_cache_dir;             // empty: program cache disabled
+    std::string m_driver_fingerprint;    // GL vendor/renderer/version
+    // ARB_get_program_binary entry points, typed in ShaderManager.cpp.
+    void* m_get_program_binary;
+    void* m_program_binary;
+    void* m_program_parameteri;
+    ShaderLoadStats m_load_stats;
 };
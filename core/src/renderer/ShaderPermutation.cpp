@@ -0,0 +1,61 @@
+#include "renderer/ShaderPermutation.hpp"
+
+namespace {
+struct FeatureDefine {
+    uint32_t bit;
+    const char* name;
+};
+
+constexpr FeatureDefine FEATURE_DEFINES[] = {
+    { SHADER_FEATURE_LIGHTING, "MIYABI_LIGHTING" },
+    { SHADER_FEATURE_ALPHA_TEST, "MIYABI_ALPHA_TEST" },
+};
+} // namespace
+
+std::string build_shader_feature_defines(uint32_t features) {
+    std::string defines;
+    for (const FeatureDefine& feature : FEATURE_DEFINES) {
+        if ((features & feature.bit) != 0) {
+            defines += "#define ";
+            defines += feature.name;
+            defines += " 1\n";
+        }
+    }
+    return defines;
+}
+
+std::string inject_shader_defines(const std::string& source, const std::string& defines) {
+    if (defines.empty()) {
+        return source;
+    }
+
+    size_t version = source.find("#version");
+    // Only a directive at the start of a line counts.
+    while (version != std::string::npos && version != 0 && source[version - 1] != '\n') {
+        version = source.find("#version", version + 1);
+    }
+    if (version == std::string::npos) {
+        return defines + "#line 1\n" + source;
+    }
+
+    const size_t line_end = source.find('\n', version);
+    if (line_end == std::string::npos) {
+        return source + "\n" + defines;
+    }
+
+    // Lines before and including #version keep their numbers; the next
+    // original line is reported as its real line number.
+    size_t version_line = 1;
+    for (size_t i = 0; i < line_end; ++i) {
+        if (source[i] == '\n') {
+            ++version_line;
+        }
+    }
+    std::string result;
+    result.reserve(source.size() + defines.size() + 16);
+    result.append(source, 0, line_end + 1);
+    result += defines;
+    result += "#line " + std::to_string(version_line + 1) + "\n";
+    result.append(source, line_end + 1, std::string::npos);
+    return result;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Feature bits selecting a variant of an uber-shader. Each set bit becomes a
+// `#define MIYABI_<NAME> 1` in both stages, so a material only pays for the
+// features it uses.
+enum ShaderFeature : uint32_t {
+    SHADER_FEATURE_NONE = 0,
+    SHADER_FEATURE_LIGHTING = 1u << 0,     // Directional Lambert lighting (needs normals)
+    SHADER_FEATURE_ALPHA_TEST = 1u << 1,   // discard below u_alphaCutoff
+};
+
+// Every bit that has a define; other bits are rejected by ShaderManager.
+constexpr uint32_t SHADER_FEATURE_ALL = SHADER_FEATURE_LIGHTING | SHADER_FEATURE_ALPHA_TEST;
+
+// Returns the define block for `features`, one `#define` per line in bit
+// order, e.g. "#define MIYABI_LIGHTING 1\n". Empty for SHADER_FEATURE_NONE.
+std::string build_shader_feature_defines(uint32_t features);
+
+// Inserts `defines` right after the `#version` line (which must stay first)
+// and resets the line counter so compiler errors still point at the file.
+// Sources without a `#version` line get the block prepended.
+std::string inject_shader_defines(const std::string& source, const std::string& defines);
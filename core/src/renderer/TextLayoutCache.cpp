@@ -0,0 +1,171 @@
+#include "renderer/TextLayoutCache.hpp"
+#include "renderer/Utf8.hpp"
+
+namespace {
+// Dynamic strings (timers, scores) leave one dead entry per distinct value;
+// sweep those once a second and forget anything idle for ~5 seconds.
+constexpr uint64_t SWEEP_INTERVAL_FRAMES = 60;
+constexpr uint64_t MAX_IDLE_FRAMES = 300;
+constexpr size_t NO_BREAK = static_cast<size_t>(-1);
+
+constexpr uint64_t FNV_OFFSET_BASIS = 1469598103934665603ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t hash_key(std::string_view text, float scale, float wrap_width) {
+    uint64_t hash = fnv1a(FNV_OFFSET_BASIS, text.data(), text.size());
+    hash = fnv1a(hash, &scale, sizeof(scale));
+    return fnv1a(hash, &wrap_width, sizeof(wrap_width));
+}
+} // namespace
+
+TextLayoutCache::TextLayoutCache(FontManager* font_manager)
+    : m_font_manager(font_manager),
+      m_frame(0) {}
+
+void TextLayoutCache::begin_frame() {
+    ++m_frame;
+    if (m_frame % SWEEP_INTERVAL_FRAMES == 0) {
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (m_frame - it->second.last_used_frame > MAX_IDLE_FRAMES) {
+                it = m_entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    m_stats = TextLayoutCacheStats{};
+    m_stats.entries = static_cast<uint32_t>(m_entries.size());
+}
+
+void TextLayoutCache::clear() {
+    m_entries.clear();
+    m_stats.entries = 0;
+}
+
+const TextLayout& TextLayoutCache::get(std::string_view text, float scale, float wrap_width) {
+    Entry& entry = m_entries[hash_key(text, scale, wrap_width)];
+    entry.last_used_frame = m_frame;
+
+    const bool same_key = entry.scale == scale && entry.wrap_width == wrap_width && entry.text == text;
+    if (same_key && entry.atlas_generation == m_font_manager->get_atlas_generation()) {
+        ++m_stats.hits;
+        // The replayed quads bypass get_glyph(), so keep their pages resident.
+        for (uint32_t page = 0; page < entry.layout.page_vertices.size(); ++page) {
+            if (!entry.layout.page_vertices[page].empty()) {
+                m_font_manager->touch_page(page);
+            }
+        }
+        return entry.layout;
+    }
+
+    // New string, hash collision, or stale atlas placement: rebuild in place.
+    ++m_stats.misses;
+    if (!same_key) {
+        entry.text.assign(text.data(), text.size());
+        entry.scale = scale;
+        entry.wrap_width = wrap_width;
+    }
+    build(text, scale, wrap_width, entry.layout);
+    // Read after building: rasterizing a missing glyph may evict a page.
+    entry.atlas_generation = m_font_manager->get_atlas_generation();
+    m_stats.entries = static_cast<uint32_t>(m_entries.size());
+    return entry.layout;
+}
+
+void TextLayoutCache::build(std::string_view text, float scale, float wrap_width, TextLayout& out) {
+    const float line_height = static_cast<float>(m_font_manager->get_line_height()) * scale;
+
+    // Pass 1: pen positions per glyph, with kerning and greedy word wrap.
+    m_scratch.clear();
+    float pen_x = 0.0f;
+    float pen_y = 0.0f;
+    size_t line_start = 0;
+    size_t word_start = NO_BREAK;
+    char32_t previous = 0;
+
+    size_t offset = 0;
+    while (offset < text.size()) {
+        const char32_t codepoint = decode_utf8(text, offset);
+        if (codepoint == U'\n') {
+            pen_x = 0.0f;
+            pen_y -= line_height;
+            line_start = m_scratch.size();
+            word_start = NO_BREAK;
+            previous = 0;
+            continue;
+        }
+
+        const Character* glyph = m_font_manager->get_glyph(codepoint);
+        if (!glyph) {
+            continue;
+        }
+        if (previous != 0) {
+            pen_x += static_cast<float>(m_font_manager->get_kerning(previous, codepoint)) * scale;
+        }
+
+        const float advance = static_cast<float>(glyph->Advance) * scale;
+        const bool overflows = wrap_width > 0.0f && codepoint != U' ' && pen_x + advance > wrap_width;
+        if (overflows && m_scratch.size() > line_start) {
+            if (word_start != NO_BREAK && word_start < m_scratch.size()) {
+                // Carry the partial word after the last space down to the new line.
+                const float shift = m_scratch[word_start].pen_x;
+                for (size_t i = word_start; i < m_scratch.size(); ++i) {
+                    m_scratch[i].pen_x -= shift;
+                    m_scratch[i].pen_y -= line_height;
+                }
+                pen_x -= shift;
+                line_start = word_start;
+            } else {
+                // No break opportunity on this line: split the word here.
+                pen_x = 0.0f;
+                line_start = m_scratch.size();
+            }
+            pen_y -= line_height;
+            word_start = NO_BREAK;
+        }
+
+        m_scratch.push_back({ *glyph, pen_x, pen_y });
+        pen_x += advance;
+        if (codepoint == U' ') {
+            word_start = m_scratch.size();
+        }
+        previous = codepoint;
+    }
+
+    // Pass 2: quads, bucketed by atlas page.
+    for (auto& vertices : out.page_vertices) {
+        vertices.clear();
+    }
+    out.glyph_count = 0;
+    for (const PlacedGlyph& placed : m_scratch) {
+        const Character& ch = placed.character;
+        if (ch.Size.x <= 0 || ch.Size.y <= 0) {
+            continue;
+        }
+        if (ch.Page >= out.page_vertices.size()) {
+            out.page_vertices.resize(ch.Page + 1);
+        }
+
+        const float xpos = placed.pen_x + ch.Bearing.x * scale;
+        const float ypos = placed.pen_y - (ch.Size.y - ch.Bearing.y) * scale;
+        const float w = ch.Size.x * scale;
+        const float h = ch.Size.y * scale;
+
+        // Top-left, bottom-left, bottom-right, top-right
+        auto& vertices = out.page_vertices[ch.Page];
+        vertices.push_back({ xpos,     ypos + h, ch.TexCoordsStart.x, ch.TexCoordsStart.y, 0.0f, 0.0f, 0.0f, 0.0f });
+        vertices.push_back({ xpos,     ypos,     ch.TexCoordsStart.x, ch.TexCoordsEnd.y,   0.0f, 0.0f, 0.0f, 0.0f });
+        vertices.push_back({ xpos + w, ypos,     ch.TexCoordsEnd.x,   ch.TexCoordsEnd.y,   0.0f, 0.0f, 0.0f, 0.0f });
+        vertices.push_back({ xpos + w, ypos + h, ch.TexCoordsEnd.x,   ch.TexCoordsStart.y, 0.0f, 0.0f, 0.0f, 0.0f });
+        ++out.glyph_count;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "renderer/FontManager.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// One corner of a glyph quad. Color is per vertex so strings with different
+// colors can share a draw call.
+struct TextVertex {
+    float x, y;
+    float u, v;
+    float r, g, b, a;
+};
+
+// Glyph quads for one string, bucketed by atlas page. Positions are relative
+// to the pen origin (baseline of the first line); color is left at zero and
+// filled in when the layout is replayed.
+struct TextLayout {
+    std::vector<std::vector<TextVertex>> page_vertices;
+    uint32_t glyph_count = 0;
+};
+
+// Lookup counters since the last begin_frame().
+struct TextLayoutCacheStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t entries = 0;
+};
+
+// Keeps laid-out strings (kerning and line wrapping applied) across frames so
+// unchanged HUD/menu text is a copy instead of a glyph walk. Entries are keyed
+// by a hash of (text, scale, wrap width); a font reload or atlas page eviction
+// bumps FontManager's atlas generation, which makes stale entries rebuild.
+class TextLayoutCache {
+public:
+    explicit TextLayoutCache(FontManager* font_manager);
+
+    // Resets counters and periodically drops entries that went unused.
+    void begin_frame();
+
+    // Returns the layout for `text`, building it on a miss. wrap_width <= 0
+    // disables wrapping; '\n' always starts a new line. The reference stays
+    // valid until the next begin_frame() or clear().
+    const TextLayout& get(std::string_view text, float scale, float wrap_width);
+
+    void clear();
+
+    const TextLayoutCacheStats& get_stats() const { return m_stats; }
+
+private:
+    struct Entry {
+        std::string text;
+        float scale = 0.0f;
+        float wrap_width = 0.0f;
+        uint64_t atlas_generation = 0;
+        uint64_t last_used_frame = 0;
+        TextLayout layout;
+    };
+
+    struct PlacedGlyph {
+        Character character;
+        float pen_x;
+        float pen_y;
+    };
+
+    void build(std::string_view text, float scale, float wrap_width, TextLayout& out);
+
+    FontManager* m_font_manager;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::vector<PlacedGlyph> m_scratch;
+    uint64_t m_frame;
+    TextLayoutCacheStats m_stats;
+};
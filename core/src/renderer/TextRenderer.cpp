@@ -1,95 +1,193 @@
 #include "renderer/TextRenderer.hpp"
 #include <iostream>
+#include <cstddef>
 #include <glad/glad.h>
-#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+constexpr size_t VERTICES_PER_QUAD = 4;
+constexpr size_t INDICES_PER_QUAD = 6;
+constexpr size_t INITIAL_QUAD_CAPACITY = 1024;
+}
 
 TextRenderer::TextRenderer(ShaderManager* shader_manager, FontManager* font_manager)
-    : m_shader_manager(shader_manager), m_font_manager(font_manager), m_text_shader_id(0) {
+    : m_shader_manager(shader_manager),
+      m_font_manager(font_manager),
+      m_text_shader_id(0),
+      m_sdf_text_shader_id(0),
+      m_vao(0),
+      m_vbo(0),
+      m_ebo(0),
+      m_vbo_capacity_bytes(0),
+      m_index_capacity_quads(0),
+      m_layout_cache(font_manager) {
+
+    // Load shaders; the fragment stage depends on how FontManager builds glyphs.
+    // Both may still be compiling in the background; flush() skips until ready.
+    m_text_shader_id = m_shader_manager->request_shader("core/src/shaders/text.vert", "core/src/shaders/text.frag");
+    m_sdf_text_shader_id = m_shader_manager->request_shader("core/src/shaders/text.vert", "core/src/shaders/text_sdf.frag");
 
-    // Load shader
-    m_text_shader_id = m_shader_manager->load_shader("core/src/shaders/text.vert", "core/src/shaders/text.frag");
-    
-    // Configure VAO/VBO for texture quads
     glGenVertexArrays(1, &m_vao);
     glGenBuffers(1, &m_vbo);
-    
+    glGenBuffers(1, &m_ebo);
+
     glBindVertexArray(m_vao);
     glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    
-    // The VBO will be filled with data for each character, 6 vertices per character.
-    // We'll use glBufferData with GL_DYNAMIC_DRAW since it will be updated frequently.
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    
-    // Vertex attribute is a vec4 (pos.x, pos.y, tex.x, tex.y)
+
+    // location 0: vec4 (pos.x, pos.y, tex.x, tex.y), location 1: vec4 color
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), reinterpret_cast<void*>(offsetof(TextVertex, x)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), reinterpret_cast<void*>(offsetof(TextVertex, r)));
+
+    // The element buffer binding is VAO state.
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    ensure_index_capacity(INITIAL_QUAD_CAPACITY);
 }
 
 TextRenderer::~TextRenderer() {
     glDeleteVertexArrays(1, &m_vao);
     glDeleteBuffers(1, &m_vbo);
+    glDeleteBuffers(1, &m_ebo);
 }
 
-void TextRenderer::render_text(const std::string& text, float x, float y, float scale, glm::vec3 color) {
-    // Activate corresponding render state	
-    m_shader_manager->use_shader(m_text_shader_id);
-    uint32_t program_id = m_shader_manager->get_program_id(m_text_shader_id);
-    if (program_id == 0) {
-        std::cerr << "TextRenderer::render_text: Could not find shader program for text rendering" << std::endl;
+void TextRenderer::ensure_index_capacity(size_t quad_count) {
+    if (quad_count <= m_index_capacity_quads) {
         return;
     }
+    size_t capacity = m_index_capacity_quads > 0 ? m_index_capacity_quads : INITIAL_QUAD_CAPACITY;
+    while (capacity < quad_count) {
+        capacity *= 2;
+    }
 
-    // Set uniforms
-    glUniform3f(glGetUniformLocation(program_id, "u_textColor"), color.x, color.y, color.z);
-    
-    // Assuming the window dimensions are known (e.g., 800x600).
-    // This should ideally come from a window or context manager.
-    glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 600.0f);
-    glUniformMatrix4fv(glGetUniformLocation(program_id, "u_projection"), 1, GL_FALSE, &projection[0][0]);
-    
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_font_manager->get_atlas_texture_id());
-    glUniform1i(glGetUniformLocation(program_id, "u_text"), 0);
+    // Quad k always uses vertices 4k..4k+3, so a per-page draw is just an
+    // offset into this shared pattern.
+    std::vector<uint32_t> indices(capacity * INDICES_PER_QUAD);
+    for (size_t quad = 0; quad < capacity; ++quad) {
+        const uint32_t base = static_cast<uint32_t>(quad * VERTICES_PER_QUAD);
+        uint32_t* out = &indices[quad * INDICES_PER_QUAD];
+        out[0] = base + 0;
+        out[1] = base + 1;
+        out[2] = base + 2;
+        out[3] = base + 0;
+        out[4] = base + 2;
+        out[5] = base + 3;
+    }
 
     glBindVertexArray(m_vao);
+    glBufferData(
+        GL_ELEMENT_ARRAY_BUFFER,
+        static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)),
+        indices.data(),
+        GL_STATIC_DRAW
+    );
+    glBindVertexArray(0);
+    m_index_capacity_quads = capacity;
+}
+
+void TextRenderer::begin_frame() {
+    for (auto& vertices : m_page_vertices) {
+        vertices.clear();
+    }
+    m_stats = TextRenderStats{};
+    m_layout_cache.begin_frame();
+}
+
+void TextRenderer::queue_text(std::string_view text, float x, float y, float scale, const glm::vec4& color,
+                              float wrap_width) {
+    ++m_stats.strings;
 
-    // Iterate through all characters
-    for (const char& c : text) {
-        const Character& ch = m_font_manager->get_character(c);
+    const TextLayout& layout = m_layout_cache.get(text, scale, wrap_width);
+    if (layout.page_vertices.size() > m_page_vertices.size()) {
+        m_page_vertices.resize(layout.page_vertices.size());
+    }
 
-        float xpos = x + ch.Bearing.x * scale;
-        float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+    // Copy the cached quads, then move them to the pen origin and tint them.
+    for (size_t page = 0; page < layout.page_vertices.size(); ++page) {
+        const auto& source = layout.page_vertices[page];
+        if (source.empty()) {
+            continue;
+        }
+        auto& out = m_page_vertices[page];
+        const size_t first = out.size();
+        out.insert(out.end(), source.begin(), source.end());
+        for (size_t i = first; i < out.size(); ++i) {
+            TextVertex& vertex = out[i];
+            vertex.x += x;
+            vertex.y += y;
+            vertex.r = color.x;
+            vertex.g = color.y;
+            vertex.b = color.z;
+            vertex.a = color.w;
+        }
+    }
+    m_stats.glyphs += layout.glyph_count;
+}
 
-        float w = ch.Size.x * scale;
-        float h = ch.Size.y * scale;
+void TextRenderer::flush(const glm::mat4& projection) {
+    const TextLayoutCacheStats& cache_stats = m_layout_cache.get_stats();
+    m_stats.layout_cache_hits = cache_stats.hits;
+    m_stats.layout_cache_misses = cache_stats.misses;
+
+    m_stream.clear();
+    for (const auto& vertices : m_page_vertices) {
+        m_stream.insert(m_stream.end(), vertices.begin(), vertices.end());
+    }
+    if (m_stream.empty()) {
+        return;
+    }
 
-        // Define the 2 triangles that form the character's quad
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   ch.TexCoordsStart.x, ch.TexCoordsStart.y },
-            { xpos,     ypos,       ch.TexCoordsStart.x, ch.TexCoordsEnd.y   },
-            { xpos + w, ypos,       ch.TexCoordsEnd.x,   ch.TexCoordsEnd.y   },
+    // Activate corresponding render state
+    const uint32_t shader_id = m_font_manager->get_render_mode() == FontRenderMode::Sdf
+        ? m_sdf_text_shader_id
+        : m_text_shader_id;
+    if (m_shader_manager->get_status(shader_id) == ShaderStatus::Pending) {
+        return;
+    }
+    uint32_t program_id = m_shader_manager->get_program_id(shader_id);
+    if (program_id == 0) {
+        std::cerr << "TextRenderer::flush: Could not find shader program for text rendering" << std::endl;
+        return;
+    }
+    m_shader_manager->use_shader(shader_id);
+    glUniformMatrix4fv(glGetUniformLocation(program_id, "u_projection"), 1, GL_FALSE, &projection[0][0]);
+    glUniform1i(glGetUniformLocation(program_id, "u_text"), 0);
 
-            { xpos,     ypos + h,   ch.TexCoordsStart.x, ch.TexCoordsStart.y },
-            { xpos + w, ypos,       ch.TexCoordsEnd.x,   ch.TexCoordsEnd.y   },
-            { xpos + w, ypos + h,   ch.TexCoordsEnd.x,   ch.TexCoordsStart.y }
-        };
+    ensure_index_capacity(m_stream.size() / VERTICES_PER_QUAD);
 
-        // Update content of VBO
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // Orphan the previous frame's storage so the driver never waits on it.
+    const size_t used_bytes = m_stream.size() * sizeof(TextVertex);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    if (used_bytes > m_vbo_capacity_bytes) {
+        m_vbo_capacity_bytes = used_bytes * 2;
+    }
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_vbo_capacity_bytes), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(used_bytes), m_stream.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        // Render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(m_vao);
 
-        // Now advance cursors for next glyph
-        x += ch.Advance * scale;
+    size_t first_quad = 0;
+    for (uint32_t page = 0; page < m_page_vertices.size(); ++page) {
+        const size_t quad_count = m_page_vertices[page].size() / VERTICES_PER_QUAD;
+        if (quad_count == 0) {
+            continue;
+        }
+        glBindTexture(GL_TEXTURE_2D, m_font_manager->get_page_texture_id(page));
+        glDrawElements(
+            GL_TRIANGLES,
+            static_cast<GLsizei>(quad_count * INDICES_PER_QUAD),
+            GL_UNSIGNED_INT,
+            reinterpret_cast<void*>(first_quad * INDICES_PER_QUAD * sizeof(uint32_t))
+        );
+        first_quad += quad_count;
+        ++m_stats.draw_calls;
     }
+    m_stats.vertices = static_cast<uint32_t>(m_stream.size());
 
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
-
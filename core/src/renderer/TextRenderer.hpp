@@ -2,21 +2,58 @@
 
 #include "renderer/ShaderManager.hpp"
 #include "renderer/FontManager.hpp"
-#include <string>
+#include "renderer/TextLayoutCache.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
 #include <glm/glm.hpp>
 
+// Submission counters for the most recent flush().
+struct TextRenderStats {
+    uint32_t draw_calls = 0;
+    uint32_t vertices = 0;
+    uint32_t glyphs = 0;
+    uint32_t strings = 0;
+    uint32_t layout_cache_hits = 0;
+    uint32_t layout_cache_misses = 0;
+};
+
 class TextRenderer {
 public:
     TextRenderer(ShaderManager* shader_manager, FontManager* font_manager);
     ~TextRenderer();
 
-    // Renders a string of text
-    void render_text(const std::string& text, float x, float y, float scale, glm::vec3 color);
+    // Drops everything queued for the previous frame.
+    void begin_frame();
+
+    // Appends the glyph quads of a UTF-8 encoded string to the frame's batch,
+    // reusing the cached layout when the same string was queued before.
+    // wrap_width > 0 wraps lines at that width. Nothing is drawn until flush().
+    void queue_text(std::string_view text, float x, float y, float scale, const glm::vec4& color,
+                    float wrap_width = 0.0f);
+
+    // Uploads every queued quad with one buffer update and issues one indexed
+    // draw per atlas page.
+    void flush(const glm::mat4& projection);
+
+    const TextRenderStats& get_stats() const { return m_stats; }
 
 private:
+    void ensure_index_capacity(size_t quad_count);
+
     ShaderManager* m_shader_manager;
     FontManager* m_font_manager;
     uint32_t m_text_shader_id;
+    uint32_t m_sdf_text_shader_id;
     unsigned int m_vao;
     unsigned int m_vbo;
+    unsigned int m_ebo;
+    size_t m_vbo_capacity_bytes;
+    size_t m_index_capacity_quads;
+    TextLayoutCache m_layout_cache;
+
+    // Quads bucketed by atlas page, then concatenated into m_stream at flush.
+    std::vector<std::vector<TextVertex>> m_page_vertices;
+    std::vector<TextVertex> m_stream;
+    TextRenderStats m_stats;
 };
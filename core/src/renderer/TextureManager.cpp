@@ -1,16 +1,17 @@
 #include "renderer/TextureManager.hpp"
+#include "profiler/Profiler.hpp"
 #include <glad/glad.h>
 #include <iostream>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "vendor/stb_image.h"
 
-TextureManager::TextureManager() : m_next_texture_id(1) {}
+TextureManager::TextureManager() = default;
 
 TextureManager::~TextureManager() {
-    for (auto const& [tex_id, gl_id] : m_texture_id_to_gl_id) {
+    m_gl_textures.for_each([](uint32_t, const uint32_t& gl_id) {
         glDeleteTextures(1, &gl_id);
-    }
+    });
 }
 
 bool TextureManager::upload_texture_to_gl(uint32_t gl_id, const std::string& path) {
@@ -58,6 +59,7 @@ uint32_t TextureManager::load_texture(const std::string& path) {
     if (existing != m_path_to_texture_id.end()) {
         return existing->second;
     }
+    MIYABI_PROFILE_SCOPE("TextureLoad");
 
     uint32_t gl_id = 0;
     glGenTextures(1, &gl_id);
@@ -71,8 +73,11 @@ uint32_t TextureManager::load_texture(const std::string& path) {
         return 0;
     }
 
-    uint32_t texture_id = m_next_texture_id++;
-    m_texture_id_to_gl_id[texture_id] = gl_id;
+    uint32_t texture_id = m_gl_textures.insert(gl_id);
+    if (texture_id == 0) {
+        glDeleteTextures(1, &gl_id);
+        return 0;
+    }
     m_path_to_texture_id[path] = texture_id;
 
     std::cout << "TextureManager: Loaded '" << path << "' with texture_id " << texture_id << " (gl_id " << gl_id << ")" << std::endl;
@@ -87,12 +92,13 @@ uint32_t TextureManager::reload_texture(const std::string& path) {
     }
 
     uint32_t texture_id = existing->second;
-    auto gl_it = m_texture_id_to_gl_id.find(texture_id);
-    if (gl_it == m_texture_id_to_gl_id.end()) {
+    const uint32_t* gl_texture = m_gl_textures.get(texture_id);
+    if (!gl_texture) {
+        m_path_to_texture_id.erase(existing);
         return load_texture(path);
     }
 
-    uint32_t gl_id = gl_it->second;
+    uint32_t gl_id = *gl_texture;
     if (!upload_texture_to_gl(gl_id, path)) {
         return texture_id;
     }
@@ -102,10 +108,9 @@ uint32_t TextureManager::reload_texture(const std::string& path) {
 }
 
 void TextureManager::bind_texture(uint32_t texture_id, uint32_t texture_unit) const {
-    auto it = m_texture_id_to_gl_id.find(texture_id);
-    if (it != m_texture_id_to_gl_id.end()) {
+    if (const uint32_t* gl_id = m_gl_textures.get(texture_id)) {
         glActiveTexture(texture_unit);
-        glBindTexture(GL_TEXTURE_2D, it->second);
+        glBindTexture(GL_TEXTURE_2D, *gl_id);
     } else {
         // Optionally bind a default texture (e.g., a white pixel)
         glActiveTexture(texture_unit);
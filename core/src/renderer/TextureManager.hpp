@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <unordered_map>
 
+#include "renderer/HandlePool.hpp"
+
 class TextureManager {
 public:
     TextureManager();
@@ -16,13 +18,17 @@ public:
     // If not loaded yet, it behaves like load_texture().
     uint32_t reload_texture(const std::string& path);
 
+    // True if `path` was loaded through load_texture().
+    bool has_texture(const std::string& path) const {
+        return m_path_to_texture_id.find(path) != m_path_to_texture_id.end();
+    }
+
     // Binds the specified texture to the given texture unit (e.g., GL_TEXTURE0).
     void bind_texture(uint32_t texture_id, uint32_t texture_unit) const;
 
 private:
     bool upload_texture_to_gl(uint32_t gl_id, const std::string& path);
 
-    uint32_t m_next_texture_id;
-    std::unordered_map<uint32_t, uint32_t> m_texture_id_to_gl_id;
-    std::unordered_map<std::string, uint32_t> m_path_to_texture_id;
+    HandlePool<uint32_t> m_gl_textures;     // texture_id -> GL texture name
+    std::unordered_map<std::string, uint32_t> m_path_to_texture_id; // load/reload only
 };
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Replacement character emitted for malformed UTF-8 input.
+constexpr char32_t UTF8_REPLACEMENT_CODEPOINT = 0xFFFD;
+
+// Decodes the code point starting at text[offset] and advances offset past it.
+// Malformed sequences (truncated, overlong, surrogates, > U+10FFFF) yield
+// UTF8_REPLACEMENT_CODEPOINT and skip a single byte so decoding can resync.
+inline char32_t decode_utf8(std::string_view text, size_t& offset) {
+    const auto byte_at = [&](size_t index) {
+        return static_cast<unsigned char>(text[index]);
+    };
+
+    const unsigned char lead = byte_at(offset);
+    if (lead < 0x80) {
+        ++offset;
+        return lead;
+    }
+
+    size_t length = 0;
+    char32_t codepoint = 0;
+    char32_t min_codepoint = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = lead & 0x1F;
+        min_codepoint = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = lead & 0x0F;
+        min_codepoint = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = lead & 0x07;
+        min_codepoint = 0x10000;
+    } else {
+        ++offset;
+        return UTF8_REPLACEMENT_CODEPOINT;
+    }
+
+    if (offset + length > text.size()) {
+        ++offset;
+        return UTF8_REPLACEMENT_CODEPOINT;
+    }
+    for (size_t i = 1; i < length; ++i) {
+        const unsigned char continuation = byte_at(offset + i);
+        if ((continuation & 0xC0) != 0x80) {
+            ++offset;
+            return UTF8_REPLACEMENT_CODEPOINT;
+        }
+        codepoint = (codepoint << 6) | (continuation & 0x3F);
+    }
+
+    if (codepoint < min_codepoint || codepoint > 0x10FFFF ||
+        (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        ++offset;
+        return UTF8_REPLACEMENT_CODEPOINT;
+    }
+
+    offset += length;
+    return codepoint;
+}
@@ -0,0 +1,54 @@
+#version 330 core
+// Permutation features are injected by ShaderManager as MIYABI_* defines
+// (see renderer/ShaderPermutation.hpp).
+out vec4 FragColor;
+
+in vec2 v_texCoord;
+
+uniform sampler2D u_texture;
+
+// Per-pass data; mirrors FrameParams in renderer/MaterialManager.hpp.
+layout (std140) uniform FrameBlock {
+    mat4 u_view;
+    mat4 u_projection;
+    vec4 u_lightDirection;
+    vec4 u_lightColor;
+};
+
+// Mirrors MaterialParams; the array size is MaterialManager::MAX_MATERIALS.
+struct MaterialParams {
+    vec4 baseColor;
+    float ambientStrength;
+    float diffuseStrength;
+    float alphaCutoff;
+    float padding;
+};
+
+layout (std140) uniform MaterialBlock {
+    MaterialParams u_materials[256];
+};
+
+// Switching materials only changes this index.
+uniform int u_materialIndex;
+
+#ifdef MIYABI_LIGHTING
+in vec3 v_worldNormal;
+#endif
+
+void main()
+{
+    MaterialParams material = u_materials[u_materialIndex];
+    vec4 albedo = texture(u_texture, v_texCoord) * material.baseColor;
+#ifdef MIYABI_ALPHA_TEST
+    if (albedo.a < material.alphaCutoff) {
+        discard;
+    }
+#endif
+#ifdef MIYABI_LIGHTING
+    float lambert = max(dot(normalize(v_worldNormal), normalize(-u_lightDirection.xyz)), 0.0);
+    vec3 lighting = vec3(material.ambientStrength) + (u_lightColor.rgb * lambert * material.diffuseStrength);
+    FragColor = vec4(albedo.rgb * clamp(lighting, 0.0, 1.0), albedo.a);
+#else
+    FragColor = albedo;
+#endif
+}
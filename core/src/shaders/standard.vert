@@ -1,21 +1,34 @@
 #version 330 core
+// Permutation features are injected by ShaderManager as MIYABI_* defines
+// (see renderer/ShaderPermutation.hpp).
 layout (location = 0) in vec3 a_position;
 layout (location = 1) in vec2 a_texCoord;
 layout (location = 2) in vec3 a_normal;
+
+// A mat4 is 4 vec4s, so it takes up 4 attribute locations.
+// We start at location 3 since 0-2 are taken by vertex attributes.
 layout (location = 3) in mat4 a_modelMatrix;
 
-uniform mat4 u_view;
-uniform mat4 u_projection;
+// Per-pass data; mirrors FrameParams in renderer/MaterialManager.hpp.
+layout (std140) uniform FrameBlock {
+    mat4 u_view;
+    mat4 u_projection;
+    vec4 u_lightDirection;
+    vec4 u_lightColor;
+};
 
 out vec2 v_texCoord;
+#ifdef MIYABI_LIGHTING
 out vec3 v_worldNormal;
+#endif
 
 void main()
 {
     vec4 world_position = a_modelMatrix * vec4(a_position, 1.0);
-    mat3 normal_matrix = transpose(inverse(mat3(a_modelMatrix)));
-
     gl_Position = u_projection * u_view * world_position;
     v_texCoord = a_texCoord;
+#ifdef MIYABI_LIGHTING
+    mat3 normal_matrix = transpose(inverse(mat3(a_modelMatrix)));
     v_worldNormal = normalize(normal_matrix * a_normal);
+#endif
 }
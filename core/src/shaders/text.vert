@@ -1,6 +1,8 @@
 #version 330 core
 layout (location = 0) in vec4 a_vertex; // vec2 position, vec2 texCoords
+layout (location = 1) in vec4 a_color;
 out vec2 v_texCoord;
+out vec4 v_color;
 
 uniform mat4 u_projection;
 
@@ -8,4 +10,5 @@ void main()
 {
     gl_Position = u_projection * vec4(a_vertex.xy, 0.0, 1.0);
     v_texCoord = a_vertex.zw;
+    v_color = a_color;
 }
@@ -0,0 +1,17 @@
+#version 330 core
+in vec2 v_texCoord;
+in vec4 v_color;
+out vec4 FragColor;
+
+uniform sampler2D u_text;
+
+void main()
+{
+    // The atlas stores a signed distance field in the red channel: 0.5 is the
+    // glyph outline, larger values are inside. Antialiasing width follows the
+    // screen-space derivative, so the same atlas stays crisp at any scale.
+    float distance = texture(u_text, v_texCoord).r;
+    float width = max(fwidth(distance), 1e-4);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+    FragColor = vec4(v_color.rgb, v_color.a * alpha);
+}
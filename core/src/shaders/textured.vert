@@ -1,19 +0,0 @@
-#version 330 core
-layout (location = 0) in vec3 a_position;
-layout (location = 1) in vec2 a_texCoord;
-layout (location = 2) in vec3 a_normal;
-
-// A mat4 is 4 vec4s, so it takes up 4 attribute locations.
-// We start at location 3 since 0-2 are taken by vertex attributes.
-layout (location = 3) in mat4 a_modelMatrix;
-
-uniform mat4 u_view;
-uniform mat4 u_projection;
-
-out vec2 v_texCoord;
-
-void main()
-{
-    gl_Position = u_projection * u_view * a_modelMatrix * vec4(a_position, 1.0);
-    v_texCoord = a_texCoord;
-}
@@ -0,0 +1,95 @@
+#include <cassert>
+#include <cstdint>
+
+#include "physics/AdaptiveStepQuality.hpp"
+
+using miyabi::physics::AdaptiveStepQuality;
+using miyabi::physics::StepQuality;
+
+namespace {
+bool same(const StepQuality& quality, uint32_t sub_steps, int32_t velocity_iterations, int32_t position_iterations) {
+    return quality.sub_steps == sub_steps && quality.velocity_iterations == velocity_iterations
+        && quality.position_iterations == position_iterations;
+}
+} // namespace
+
+int main() {
+    {
+        // Without a budget nothing changes, however slow the steps are.
+        AdaptiveStepQuality quality;
+        quality.configure({2, 6, 2}, 0.0);
+        assert(!quality.adaptive());
+        for (int i = 0; i < 10; ++i) {
+            quality.record_step(100.0);
+        }
+        assert(quality.level() == 0 && same(quality.current(), 2, 6, 2));
+    }
+
+    {
+        // Drops go sub-steps first, then velocity, then position iterations,
+        // one per slow step, and stop with everything at one.
+        AdaptiveStepQuality quality;
+        quality.configure({3, 3, 2}, 1.0);
+        assert(quality.max_level() == 5);
+        const StepQuality expected[] = {
+            {2, 3, 2}, {1, 3, 2}, {1, 2, 2}, {1, 1, 2}, {1, 1, 1}, {1, 1, 1},
+        };
+        for (const StepQuality& next : expected) {
+            quality.record_step(1.5);
+            assert(same(quality.current(), next.sub_steps, next.velocity_iterations, next.position_iterations));
+        }
+        assert(quality.level() == 5);
+    }
+
+    {
+        // A notch comes back after RECOVER_STEPS consecutive calm steps; a
+        // step between the recover fraction and the budget restarts the run.
+        AdaptiveStepQuality quality;
+        quality.configure({2, 6, 2}, 10.0);
+        quality.record_step(11.0);
+        quality.record_step(11.0);
+        assert(quality.level() == 2 && same(quality.current(), 1, 5, 2));
+
+        for (uint32_t i = 0; i + 1 < AdaptiveStepQuality::RECOVER_STEPS; ++i) {
+            quality.record_step(1.0);
+        }
+        assert(quality.level() == 2);
+        quality.record_step(8.0); // calm enough to keep, not to recover
+        for (uint32_t i = 0; i + 1 < AdaptiveStepQuality::RECOVER_STEPS; ++i) {
+            quality.record_step(1.0);
+        }
+        assert(quality.level() == 2);
+        quality.record_step(1.0);
+        assert(quality.level() == 1 && same(quality.current(), 1, 6, 2));
+
+        // A slow step also restarts the run.
+        for (uint32_t i = 0; i + 1 < AdaptiveStepQuality::RECOVER_STEPS; ++i) {
+            quality.record_step(1.0);
+        }
+        quality.record_step(11.0);
+        assert(quality.level() == 2);
+        for (uint32_t i = 0; i < AdaptiveStepQuality::RECOVER_STEPS; ++i) {
+            quality.record_step(1.0);
+        }
+        assert(quality.level() == 1);
+        for (uint32_t i = 0; i < 3 * AdaptiveStepQuality::RECOVER_STEPS; ++i) {
+            quality.record_step(1.0);
+        }
+        assert(quality.level() == 0 && same(quality.current(), 2, 6, 2));
+    }
+
+    {
+        // Reconfiguring starts again from the new full quality.
+        AdaptiveStepQuality quality;
+        quality.configure({1, 6, 2}, 1.0);
+        quality.record_step(2.0);
+        quality.record_step(2.0);
+        assert(quality.level() == 2);
+        quality.configure({4, 8, 3}, 1.0);
+        assert(quality.level() == 0 && same(quality.current(), 4, 8, 3));
+        quality.record_step(2.0);
+        assert(same(quality.current(), 3, 8, 3));
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "assets/AssetWatcher.hpp"
+
+int main() {
+    using Clock = ChangeDebouncer::Clock;
+    using std::chrono::milliseconds;
+    const Clock::time_point t0 = Clock::now();
+
+    {
+        // A path is held until it has been quiet for the whole window.
+        ChangeDebouncer debouncer(milliseconds(100));
+        debouncer.record("assets/player.png", t0);
+        assert(debouncer.pending_count() == 1);
+        assert(debouncer.take_ready(t0 + milliseconds(50)).empty());
+        const std::vector<std::string> ready = debouncer.take_ready(t0 + milliseconds(100));
+        assert(ready.size() == 1 && ready[0] == "assets/player.png");
+        assert(debouncer.pending_count() == 0);
+        assert(debouncer.take_ready(t0 + milliseconds(500)).empty());
+    }
+
+    {
+        // Repeated writes to one file restart its window and coalesce.
+        ChangeDebouncer debouncer(milliseconds(100));
+        debouncer.record("core/src/shaders/standard.frag", t0);
+        debouncer.record("core/src/shaders/standard.frag", t0 + milliseconds(80));
+        assert(debouncer.pending_count() == 1);
+        assert(debouncer.take_ready(t0 + milliseconds(120)).empty());
+        assert(debouncer.take_ready(t0 + milliseconds(180)).size() == 1);
+    }
+
+    {
+        // Ready paths come back sorted; paths still settling stay pending.
+        ChangeDebouncer debouncer(milliseconds(100));
+        debouncer.record("assets/b.obj", t0);
+        debouncer.record("assets/a.png", t0);
+        debouncer.record("assets/c.png", t0 + milliseconds(90));
+        const std::vector<std::string> ready = debouncer.take_ready(t0 + milliseconds(100));
+        assert((ready == std::vector<std::string>{ "assets/a.png", "assets/b.obj" }));
+        assert(debouncer.pending_count() == 1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "physics/BodySlotMap.hpp"
+
+using miyabi::physics::BodySlotMap;
+
+int main() {
+    {
+        // First-generation ids are 1, 2, 3, ...; 0 never resolves.
+        BodySlotMap map;
+        assert(map.insert() == 1);
+        assert(map.insert() == 2);
+        assert(map.insert() == 3);
+        assert(map.size() == 3);
+        assert(map.dense_index(2) == 1);
+        assert(map.dense_index(0) == BodySlotMap::NPOS);
+        assert(map.dense_index(4) == BodySlotMap::NPOS);
+    }
+
+    {
+        // Removal swaps the last entry into the hole; callers mirror it.
+        BodySlotMap map;
+        std::vector<int> values;
+        for (int i = 0; i < 4; ++i) {
+            map.insert();
+            values.push_back(i);
+        }
+        size_t removed = 0;
+        assert(map.remove(2, removed));
+        assert(removed == 1);
+        values[removed] = values.back();
+        values.pop_back();
+        assert(map.size() == 3 && values.size() == 3);
+        assert(map.dense_index(4) == 1 && values[1] == 3);
+        assert(map.id_at(1) == 4);
+        assert(!map.remove(2, removed));
+
+        // Removing the last entry needs no move.
+        assert(map.remove(4, removed));
+        assert(removed == 1 && map.size() == 2);
+        assert(map.dense_index(3) == 1);
+    }
+
+    {
+        // Stale ids stay invalid after their slot is reused.
+        BodySlotMap map;
+        const uint64_t first = map.insert();
+        size_t removed = 0;
+        assert(map.remove(first, removed));
+        const uint64_t reused = map.insert();
+        assert(BodySlotMap::slot_of(reused) == BodySlotMap::slot_of(first));
+        assert(BodySlotMap::generation_of(reused) == 1);
+        assert(!map.contains(first));
+        assert(map.contains(reused));
+    }
+
+    {
+        // Spawn/despawn churn keeps the slot count at the peak live count.
+        BodySlotMap map;
+        std::vector<uint64_t> live;
+        for (int round = 0; round < 1000; ++round) {
+            live.push_back(map.insert());
+            live.push_back(map.insert());
+            size_t removed = 0;
+            assert(map.remove(live.front(), removed));
+            live.erase(live.begin());
+            if (live.size() > 8) {
+                assert(map.remove(live.front(), removed));
+                live.erase(live.begin());
+            }
+        }
+        assert(map.size() == live.size());
+        assert(map.slot_count() <= 10);
+        for (uint64_t id : live) {
+            assert(map.contains(id));
+        }
+
+        map.clear();
+        assert(map.size() == 0);
+        for (uint64_t id : live) {
+            assert(!map.contains(id));
+        }
+    }
+
+    {
+        // A restored map hands out the same ids as the original.
+        BodySlotMap map;
+        const uint64_t a = map.insert();
+        const uint64_t b = map.insert();
+        map.insert();
+        size_t removed = 0;
+        assert(map.remove(b, removed));
+
+        std::vector<uint32_t> generations;
+        for (size_t slot = 0; slot < map.slot_count(); ++slot) {
+            generations.push_back(map.generation_at(slot));
+        }
+        std::vector<uint64_t> dense;
+        for (size_t i = 0; i < map.size(); ++i) {
+            dense.push_back(map.id_at(i));
+        }
+
+        BodySlotMap restored;
+        assert(restored.restore(generations, map.free_slots(), dense));
+        assert(restored.size() == map.size());
+        assert(restored.dense_index(a) == map.dense_index(a));
+        assert(!restored.contains(b));
+        assert(restored.insert() == map.insert());
+
+        // Inconsistent parts are rejected and leave the map alone.
+        BodySlotMap untouched;
+        const uint64_t kept = untouched.insert();
+        assert(!untouched.restore(generations, { 0 }, dense));          // slot 0 is live
+        assert(!untouched.restore(generations, {}, { b }));             // stale generation
+        assert(!untouched.restore(generations, {}, { a, a }));          // duplicate id
+        assert(!untouched.restore({}, {}, { a }));                      // unknown slot
+        assert(untouched.size() == 1 && untouched.contains(kept));
+    }
+
+    return 0;
+}
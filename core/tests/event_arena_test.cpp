@@ -0,0 +1,74 @@
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "physics/EventArena.hpp"
+
+using miyabi::physics::EventArena;
+
+struct TestEvent {
+    int value;
+};
+
+int main() {
+    {
+        // Nothing is published before the first publish().
+        EventArena<TestEvent> arena;
+        arena.reserve(4);
+        assert(arena.published().empty());
+        arena.begin_write();
+        assert(arena.push({1}));
+        assert(arena.published().empty());
+        arena.publish();
+        assert(arena.published().size() == 1 && arena.published()[0].value == 1);
+    }
+
+    {
+        // The published buffer survives the next write and moves only on
+        // publish(); its storage is never reallocated.
+        EventArena<TestEvent> arena;
+        arena.reserve(4);
+        arena.begin_write();
+        arena.push({1});
+        arena.push({2});
+        arena.publish();
+        const std::vector<TestEvent>& first = arena.published();
+        const TestEvent* first_data = first.data();
+
+        arena.begin_write();
+        arena.push({3});
+        assert(&arena.published() == &first);
+        assert(first.size() == 2 && first[1].value == 2);
+        arena.publish();
+        assert(arena.published().size() == 1 && arena.published()[0].value == 3);
+
+        arena.begin_write();
+        arena.push({4});
+        arena.publish();
+        assert(arena.published().data() == first_data);
+        assert(arena.published()[0].value == 4);
+    }
+
+    {
+        // Writes past the capacity are dropped and counted per publish.
+        EventArena<TestEvent> arena;
+        arena.reserve(3);
+        arena.begin_write();
+        const TestEvent batch[] = {{1}, {2}};
+        assert(arena.append(batch, 2) == 2);
+        assert(arena.append(batch, 2) == 1);
+        assert(!arena.push({5}));
+        arena.publish();
+        assert(arena.published().size() == 3);
+        assert(arena.published()[2].value == 1);
+        assert(arena.dropped() == 2);
+
+        arena.begin_write();
+        arena.push({6});
+        arena.publish();
+        assert(arena.dropped() == 0);
+        assert(arena.published().capacity() >= 3);
+    }
+
+    return 0;
+}
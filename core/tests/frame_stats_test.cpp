@@ -0,0 +1,89 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "profiler/FrameStats.hpp"
+
+using miyabi::profiler::FrameStats;
+using miyabi::profiler::FrameTimeHistogram;
+using miyabi::profiler::FrameTimePercentiles;
+
+namespace {
+bool near(double lhs, double rhs) {
+    return std::fabs(lhs - rhs) < 1e-6;
+}
+} // namespace
+
+int main() {
+    {
+        const FrameTimePercentiles empty = FrameTimeHistogram(0).percentiles();
+        assert(empty.frames == 0 && empty.p50_ms == 0.0 && empty.max_ms == 0.0);
+    }
+
+    {
+        // 1..100 ms: nearest rank on 0.1 ms bucket upper edges, exact max.
+        FrameTimeHistogram histogram(0);
+        for (int ms = 100; ms >= 1; --ms) {
+            histogram.add(static_cast<double>(ms) - 0.05);
+        }
+        const FrameTimePercentiles summary = histogram.percentiles();
+        assert(summary.frames == 100);
+        assert(near(summary.p50_ms, 50.0));
+        assert(near(summary.p95_ms, 95.0));
+        assert(near(summary.p99_ms, 99.0));
+        assert(near(summary.max_ms, 99.95));
+        assert(near(histogram.min_ms(), 0.95));
+    }
+
+    {
+        // Frames beyond the last bucket report the exact max.
+        FrameTimeHistogram histogram(0);
+        histogram.add(16.0);
+        histogram.add(250.0);
+        assert(near(histogram.percentiles().p99_ms, 250.0));
+        assert(near(histogram.percentiles().p50_ms, 16.1));
+    }
+
+    {
+        // A window forgets old frames, including the max.
+        FrameTimeHistogram histogram(4);
+        histogram.add(80.0);
+        for (int i = 0; i < 4; ++i) {
+            histogram.add(10.0);
+        }
+        const FrameTimePercentiles summary = histogram.percentiles();
+        assert(summary.frames == 4);
+        assert(near(summary.max_ms, 10.0));
+        assert(near(summary.p99_ms, 10.0));
+        assert(near(histogram.sum_ms(), 40.0));
+        assert(near(histogram.min_ms(), 10.0));
+    }
+
+    {
+        // Hitches are frames over budget; the total keeps every frame.
+        FrameStats stats(20.0);
+        assert(!stats.add_frame(16.6));
+        assert(stats.add_frame(45.0));
+        assert(!stats.add_frame(20.0));
+        assert(stats.hitches() == 1 && stats.window_hitches() == 1);
+        stats.reset_window_hitches();
+        assert(stats.window_hitches() == 0 && stats.hitches() == 1);
+        assert(stats.frame_index() == 3 && stats.total().frames() == 3);
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "miyabi_frame_stats_test.json";
+        assert(stats.write_json(path.string()));
+        std::ifstream in(path);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        const std::string json = contents.str();
+        assert(json.find("\"name\": \"frame_time\"") != std::string::npos);
+        assert(json.find("\"hitches\": 1") != std::string::npos);
+        assert(json.find("\"iterations\": 3") != std::string::npos);
+        std::filesystem::remove(path);
+    }
+
+    return 0;
+}
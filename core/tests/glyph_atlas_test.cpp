@@ -0,0 +1,97 @@
+#include <cassert>
+#include <string_view>
+
+#include "renderer/GlyphAtlas.hpp"
+#include "renderer/Utf8.hpp"
+
+int main() {
+    {
+        GlyphAtlas atlas(64, 64, 2, 1);
+        const GlyphAtlasAllocation first = atlas.allocate(10, 10, 1);
+        assert(first.ok);
+        assert(first.created_page);
+        assert(!first.evicted_page);
+        assert(first.region.page == 0);
+        assert(first.region.x == 0);
+        assert(first.region.y == 0);
+
+        // Same shelf, shifted by width + padding.
+        const GlyphAtlasAllocation second = atlas.allocate(10, 8, 1);
+        assert(second.ok);
+        assert(!second.created_page);
+        assert(second.region.page == 0);
+        assert(second.region.x == 11);
+        assert(second.region.y == 0);
+
+        // Taller than the first shelf: opens a new shelf below it.
+        const GlyphAtlasAllocation tall = atlas.allocate(10, 20, 1);
+        assert(tall.ok);
+        assert(tall.region.page == 0);
+        assert(tall.region.x == 0);
+        assert(tall.region.y == 11);
+    }
+
+    {
+        // Larger than a page can ever hold.
+        GlyphAtlas atlas(32, 32, 1, 1);
+        assert(!atlas.allocate(32, 8, 1).ok);
+        assert(atlas.page_count() == 0);
+    }
+
+    {
+        // One 31x31 glyph fills a 32x32 page, so every allocation needs a page.
+        GlyphAtlas atlas(32, 32, 2, 1);
+        const GlyphAtlasAllocation a = atlas.allocate(31, 31, 1);
+        const GlyphAtlasAllocation b = atlas.allocate(31, 31, 2);
+        assert(a.ok && a.created_page && a.region.page == 0);
+        assert(b.ok && b.created_page && b.region.page == 1);
+        assert(atlas.page_count() == 2);
+
+        // Page 1 is used in frame 3, so page 0 is the least recently used.
+        atlas.touch(1, 3);
+        const GlyphAtlasAllocation c = atlas.allocate(31, 31, 4);
+        assert(c.ok);
+        assert(c.evicted_page);
+        assert(c.region.page == 0);
+
+        // Both pages are now referenced by frame 4: nothing may be evicted.
+        atlas.touch(1, 4);
+        const GlyphAtlasAllocation d = atlas.allocate(31, 31, 4);
+        assert(!d.ok);
+
+        // Next frame, page 0 (frame 4) and page 1 (frame 4) tie; first wins.
+        const GlyphAtlasAllocation e = atlas.allocate(31, 31, 5);
+        assert(e.ok);
+        assert(e.evicted_page);
+        assert(e.region.page == 0);
+    }
+
+    {
+        const std::string_view text = "A\xC3\xA9\xE3\x81\x82\xF0\x9F\x98\x80";
+        size_t offset = 0;
+        assert(decode_utf8(text, offset) == U'A');
+        assert(decode_utf8(text, offset) == U'é');
+        assert(decode_utf8(text, offset) == U'あ');
+        assert(decode_utf8(text, offset) == U'\U0001F600');
+        assert(offset == text.size());
+    }
+
+    {
+        // Truncated sequence, stray continuation byte, overlong encoding, surrogate.
+        const std::string_view text = "\xE3\x81" "A" "\x80" "\xC0\xAF" "\xED\xA0\x80" "Z";
+        size_t offset = 0;
+        size_t replacements = 0;
+        char32_t last = 0;
+        while (offset < text.size()) {
+            last = decode_utf8(text, offset);
+            if (last == UTF8_REPLACEMENT_CODEPOINT) {
+                ++replacements;
+            }
+        }
+        assert(last == U'Z');
+        assert(replacements == 8);
+        assert(offset == text.size());
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "renderer/HandlePool.hpp"
+
+int main() {
+    {
+        // First-generation handles equal their slot index; 0 is never valid.
+        HandlePool<std::string> pool;
+        const uint32_t first = pool.insert("quad");
+        const uint32_t second = pool.insert("cube");
+        assert(first == 1);
+        assert(second == 2);
+        assert(pool.size() == 2);
+        assert(*pool.get(first) == "quad");
+        assert(pool.get(0) == nullptr);
+        assert(pool.get(3) == nullptr);
+    }
+
+    {
+        // Stale handles stop resolving once the slot is removed and reused.
+        HandlePool<int> pool;
+        const uint32_t handle = pool.insert(10);
+        assert(pool.remove(handle));
+        assert(!pool.remove(handle));
+        assert(pool.get(handle) == nullptr);
+        const uint32_t reused = pool.insert(20);
+        assert(HandlePool<int>::index_of(reused) == HandlePool<int>::index_of(handle));
+        assert(HandlePool<int>::generation_of(reused) == 1);
+        assert(pool.get(handle) == nullptr);
+        assert(*pool.get(reused) == 20);
+        assert(pool.size() == 1);
+    }
+
+    {
+        // Explicit slots leave the skipped ones to insert(), lowest first.
+        HandlePool<int> pool;
+        assert(pool.insert(1) == 1);
+        assert(pool.insert_at(100, 100) == 100);
+        assert(pool.insert_at(100, 5) == 0);
+        assert(pool.insert_at(0, 5) == 0);
+        assert(pool.insert(2) == 2);
+        assert(pool.insert_at(50, 50) == 50);
+        assert(pool.insert(3) == 3);
+        assert(*pool.get(100) == 100);
+        assert(pool.size() == 5);
+
+        std::vector<uint32_t> visited;
+        pool.for_each([&visited](uint32_t handle, int&) { visited.push_back(handle); });
+        assert((visited == std::vector<uint32_t>{ 1, 2, 3, 50, 100 }));
+    }
+
+    {
+        // A slot whose generation would wrap is retired, never reused.
+        HandlePool<int> pool;
+        uint32_t handle = pool.insert(0);
+        for (uint32_t generation = 0; generation < HandlePool<int>::MAX_GENERATION; ++generation) {
+            assert(pool.remove(handle));
+            handle = pool.insert(0);
+            assert(HandlePool<int>::index_of(handle) == 1);
+        }
+        assert(HandlePool<int>::generation_of(handle) == HandlePool<int>::MAX_GENERATION);
+        assert(pool.remove(handle));
+        assert(HandlePool<int>::index_of(pool.insert(0)) == 2);
+    }
+
+    return 0;
+}
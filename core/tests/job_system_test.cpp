@@ -0,0 +1,59 @@
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "jobs/JobSystem.hpp"
+
+using miyabi::jobs::JobSystem;
+
+int main() {
+    {
+        // Every index runs exactly once, across repeated calls.
+        JobSystem jobs(3);
+        assert(jobs.worker_count() == 3 && jobs.participant_count() == 4);
+        for (int round = 0; round < 50; ++round) {
+            std::vector<std::atomic<int>> hits(97);
+            jobs.parallel_for(hits.size(), [&](size_t index, size_t participant) {
+                assert(participant < jobs.participant_count());
+                hits[index].fetch_add(1);
+            });
+            for (const auto& hit : hits) {
+                assert(hit.load() == 1);
+            }
+        }
+    }
+
+    {
+        // Static scheduling pins index i to participant i % participants.
+        JobSystem jobs(2);
+        std::vector<size_t> owner(10, 99);
+        std::vector<std::thread::id> thread_of(10);
+        jobs.parallel_for(owner.size(), [&](size_t index, size_t participant) {
+            owner[index] = participant;
+            thread_of[index] = std::this_thread::get_id();
+        }, true);
+        for (size_t i = 0; i < owner.size(); ++i) {
+            assert(owner[i] == i % 3);
+        }
+        assert(thread_of[0] == std::this_thread::get_id());
+        assert(thread_of[3] == std::this_thread::get_id());
+        assert(thread_of[1] != std::this_thread::get_id());
+        assert(thread_of[1] == thread_of[4]);
+    }
+
+    {
+        // Without workers everything runs inline on the caller.
+        JobSystem jobs(0);
+        size_t sum = 0;
+        jobs.parallel_for(5, [&](size_t index, size_t participant) {
+            assert(participant == 0);
+            sum += index;
+        });
+        assert(sum == 10);
+        jobs.parallel_for(0, [&](size_t, size_t) { assert(false); });
+    }
+
+    return 0;
+}
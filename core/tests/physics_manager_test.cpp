@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "jobs/JobSystem.hpp"
+#include "miyabi_logic_cxx/lib.h"
+#include "physics/PhysicsManager.hpp"
+
+using miyabi::jobs::JobSystem;
+using miyabi::physics::PhysicsManager;
+
+namespace {
+
+BodyDesc make_box(BodyKind kind, float x, float y, float half_size, uint16_t category_bits) {
+    BodyDesc desc{};
+    desc.kind = kind;
+    desc.shape = BodyShapeType::Box;
+    desc.position = {x, y};
+    desc.half_extents = {half_size, half_size};
+    desc.density = kind == BodyKind::Dynamic ? 1.0f : 0.0f;
+    desc.friction = 0.3f;
+    desc.category_bits = category_bits;
+    desc.mask_bits = 0xFFFF;
+    return desc;
+}
+
+bool approx(float a, float b) {
+    return std::fabs(a - b) < 1e-4f;
+}
+
+std::vector<BodyState> step_and_fill(PhysicsManager& physics, const std::vector<PhysicsManager::BodyId>& ids, int steps) {
+    for (int i = 0; i < steps; ++i) {
+        physics.step();
+    }
+    std::vector<BodyState> states(ids.size());
+    assert(physics.fill_body_states(ids.data(), ids.size(), states.data()) == ids.size());
+    return states;
+}
+
+bool same_states(const std::vector<BodyState>& a, const std::vector<BodyState>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].position.x != b[i].position.x || a[i].position.y != b[i].position.y ||
+            a[i].angle != b[i].angle || a[i].velocity.x != b[i].velocity.x || a[i].velocity.y != b[i].velocity.y) {
+            return false;
+        }
+    }
+    return a.size() == b.size();
+}
+
+bool same_hit(const QueryHit& a, const QueryHit& b) {
+    return a.body == b.body && a.point.x == b.point.x && a.point.y == b.point.y &&
+        a.normal.x == b.normal.x && a.normal.y == b.normal.y && a.fraction == b.fraction;
+}
+
+} // namespace
+
+int main() {
+    // Unit boxes centred at x = 0, 3, 6 (category 1) and 9 (category 2).
+    PhysicsManager physics;
+    physics.init();
+    std::vector<PhysicsManager::BodyId> ids;
+    for (int i = 0; i < 4; ++i) {
+        const uint16_t category = i == 3 ? 0x0002 : 0x0001;
+        ids.push_back(physics.create_body(make_box(BodyKind::Static, 3.0f * i, 0.0f, 0.5f, category)));
+        assert(ids.back() != 0);
+    }
+
+    {
+        // Rays report the closest hit that passes the mask; misses and
+        // zero-length rays leave body 0.
+        RayCastQuery queries[4] = {
+            { {-5.0f, 0.0f}, {20.0f, 0.0f}, 0xFFFF },
+            { {-5.0f, 0.0f}, {20.0f, 0.0f}, 0x0002 },
+            { {-5.0f, 0.0f}, {0.0f, 20.0f}, 0xFFFF },
+            { {0.0f, 0.0f}, {0.0f, 0.0f}, 0xFFFF },
+        };
+        QueryHit hits[4];
+        assert(physics.raycast(queries, 4, hits) == 2);
+        assert(hits[0].body == ids[0]);
+        assert(approx(hits[0].fraction, 4.5f / 20.0f));
+        assert(approx(hits[0].point.x, -0.5f) && approx(hits[0].normal.x, -1.0f));
+        assert(hits[1].body == ids[3]);
+        assert(approx(hits[1].point.x, 8.5f));
+        assert(hits[2].body == 0);
+        assert(hits[3].body == 0);
+    }
+
+    {
+        // Shape casts hit the first box in their path; polygons never hit.
+        ShapeCastQuery queries[3] = {};
+        queries[0].shape = BodyShapeType::Circle;
+        queries[0].position = {-5.0f, 0.0f};
+        queries[0].radius = 0.25f;
+        queries[0].translation = {20.0f, 0.0f};
+        queries[0].mask_bits = 0xFFFF;
+        queries[1] = queries[0];
+        queries[1].shape = BodyShapeType::Box;
+        queries[1].half_extents = {0.25f, 0.25f};
+        queries[1].position = {1.5f, 0.0f};
+        queries[2] = queries[0];
+        queries[2].shape = BodyShapeType::Polygon;
+        QueryHit hits[3];
+        assert(physics.shape_cast(queries, 3, hits) == 2);
+        assert(hits[0].body == ids[0]);
+        assert(hits[0].fraction > 0.0f && hits[0].fraction < 4.5f / 20.0f);
+        assert(hits[1].body == ids[1]);
+        assert(hits[2].body == 0);
+    }
+
+    {
+        // AABB ids are packed in query order; ranges point into out_ids.
+        AabbQuery queries[3] = {
+            { {-1.0f, -1.0f}, {10.0f, 1.0f}, 0xFFFF },
+            { {2.0f, -1.0f}, {4.0f, 1.0f}, 0xFFFF },
+            { {-1.0f, -1.0f}, {10.0f, 1.0f}, 0x0002 },
+        };
+        std::vector<PhysicsManager::BodyId> out(8, 0);
+        QueryRange ranges[3];
+        assert(physics.query_aabb(queries, 3, out.data(), out.size(), ranges) == 6);
+        assert(ranges[0].offset == 0 && ranges[0].count == 4 && ranges[0].found == 4);
+        assert(ranges[1].offset == 4 && ranges[1].count == 1 && ranges[1].found == 1);
+        assert(ranges[2].offset == 5 && ranges[2].count == 1 && ranges[2].found == 1);
+        std::vector<PhysicsManager::BodyId> all(out.begin(), out.begin() + 4);
+        std::sort(all.begin(), all.end());
+        assert(all == ids);
+        assert(out[4] == ids[1]);
+        assert(out[5] == ids[3]);
+    }
+
+    {
+        // Ids that do not fit are dropped but still counted in found; later
+        // queries get empty ranges at the end of the buffer.
+        AabbQuery queries[2] = {
+            { {-1.0f, -1.0f}, {10.0f, 1.0f}, 0xFFFF },
+            { {2.0f, -1.0f}, {4.0f, 1.0f}, 0xFFFF },
+        };
+        PhysicsManager::BodyId out[3] = {};
+        QueryRange ranges[2];
+        assert(physics.query_aabb(queries, 2, out, 3, ranges) == 3);
+        assert(ranges[0].offset == 0 && ranges[0].count == 3 && ranges[0].found == 4);
+        assert(ranges[1].offset == 3 && ranges[1].count == 0 && ranges[1].found == 1);
+        for (PhysicsManager::BodyId id : out) {
+            assert(std::find(ids.begin(), ids.end(), id) != ids.end());
+        }
+    }
+
+    {
+        // Large batches run on the job system and match the serial results.
+        std::vector<RayCastQuery> rays;
+        std::vector<ShapeCastQuery> casts;
+        for (int i = 0; i < 200; ++i) {
+            const float y = -1.0f + 0.01f * static_cast<float>(i);
+            rays.push_back({ {-5.0f, y}, {20.0f, 0.0f}, static_cast<uint16_t>(i % 3 == 0 ? 0x0002 : 0xFFFF) });
+            ShapeCastQuery cast{};
+            cast.shape = BodyShapeType::Circle;
+            cast.position = {-5.0f + 0.05f * static_cast<float>(i), y};
+            cast.radius = 0.1f;
+            cast.translation = {20.0f, 0.0f};
+            cast.mask_bits = 0xFFFF;
+            casts.push_back(cast);
+        }
+        std::vector<QueryHit> serial_rays(rays.size());
+        std::vector<QueryHit> serial_casts(casts.size());
+        const size_t ray_hits = physics.raycast(rays.data(), rays.size(), serial_rays.data());
+        const size_t cast_hits = physics.shape_cast(casts.data(), casts.size(), serial_casts.data());
+        assert(ray_hits > 0 && ray_hits < rays.size());
+        assert(cast_hits > 0);
+
+        JobSystem jobs(3);
+        physics.set_job_system(&jobs);
+        std::vector<QueryHit> parallel_rays(rays.size());
+        std::vector<QueryHit> parallel_casts(casts.size());
+        assert(physics.raycast(rays.data(), rays.size(), parallel_rays.data()) == ray_hits);
+        assert(physics.shape_cast(casts.data(), casts.size(), parallel_casts.data()) == cast_hits);
+        physics.set_job_system(nullptr);
+        for (size_t i = 0; i < rays.size(); ++i) {
+            assert(same_hit(serial_rays[i], parallel_rays[i]));
+            assert(same_hit(serial_casts[i], parallel_casts[i]));
+        }
+    }
+
+    {
+        // Contacts can begin before the first step(): restore_snapshot steps
+        // its fresh worlds itself. A box resting on the ground must not
+        // stall the contact listener's begin-event table.
+        PhysicsManager world;
+        world.init();
+        BodyDesc ground = make_box(BodyKind::Static, 0.0f, -0.5f, 0.5f, 0x0001);
+        ground.half_extents = {20.0f, 0.5f};
+        assert(world.create_body(ground) != 0);
+        const PhysicsManager::BodyId box = world.create_body(make_box(BodyKind::Dynamic, 0.0f, 0.5f, 0.5f, 0x0001));
+        std::vector<uint8_t> snapshot;
+        world.save_snapshot(snapshot);
+        assert(world.restore_snapshot(snapshot.data(), snapshot.size()));
+        assert(world.get_collision_events().empty());
+        world.step();
+        assert(world.get_body_position(box).y > 0.4f);
+    }
+
+    {
+        // A restored world continues bit for bit like the saved one, warm
+        // starting included. Tilted boxes rock on a static ground, so every
+        // island has one contact and nothing settles long enough to sleep.
+        PhysicsManager world;
+        world.init();
+        BodyDesc ground = make_box(BodyKind::Static, 0.0f, -0.5f, 0.5f, 0x0001);
+        ground.half_extents = {20.0f, 0.5f};
+        assert(world.create_body(ground) != 0);
+        std::vector<PhysicsManager::BodyId> boxes;
+        const float angles[4] = {0.0f, 0.3f, -0.2f, 0.6f};
+        for (int i = 0; i < 4; ++i) {
+            BodyDesc desc = make_box(BodyKind::Dynamic, -6.0f + 4.0f * i, 1.0f, 0.5f, 0x0001);
+            desc.angle = angles[i];
+            boxes.push_back(world.create_body(desc));
+        }
+
+        step_and_fill(world, boxes, 30);
+        std::vector<uint8_t> snapshot;
+        world.save_snapshot(snapshot);
+        const std::vector<BodyState> continued = step_and_fill(world, boxes, 10);
+
+        assert(world.restore_snapshot(snapshot.data(), snapshot.size()));
+        const std::vector<BodyState> restored = step_and_fill(world, boxes, 10);
+        assert(same_states(continued, restored));
+
+        assert(world.restore_snapshot(snapshot.data(), snapshot.size()));
+        assert(same_states(restored, step_and_fill(world, boxes, 10)));
+    }
+
+    {
+        // Out-of-range step settings are rejected and the old ones kept.
+        PhysicsManager world;
+        world.init();
+        const PhysicsStepConfig defaults = world.step_config();
+        assert(defaults.sub_steps == 1 && defaults.velocity_iterations == 6 && defaults.position_iterations == 2);
+        assert(defaults.budget_ms == 0.0f);
+        auto rejected = [&world](void (*change)(PhysicsStepConfig&)) {
+            PhysicsStepConfig config = world.step_config();
+            change(config);
+            return !world.set_step_config(config);
+        };
+        assert(rejected([](PhysicsStepConfig& c) { c.time_step = 0.0f; }));
+        assert(rejected([](PhysicsStepConfig& c) { c.time_step = std::numeric_limits<float>::quiet_NaN(); }));
+        assert(rejected([](PhysicsStepConfig& c) { c.velocity_iterations = 0; }));
+        assert(rejected([](PhysicsStepConfig& c) { c.position_iterations = 0; }));
+        assert(rejected([](PhysicsStepConfig& c) { c.sub_steps = 0; }));
+        assert(rejected([](PhysicsStepConfig& c) { c.sub_steps = 17; }));
+        assert(rejected([](PhysicsStepConfig& c) { c.budget_ms = -1.0f; }));
+        assert(rejected([](PhysicsStepConfig& c) { c.budget_ms = std::numeric_limits<float>::infinity(); }));
+        assert(world.step_config().sub_steps == defaults.sub_steps);
+
+        PhysicsStepConfig config = defaults;
+        config.time_step = 1.0f / 120.0f;
+        config.sub_steps = 16;
+        config.velocity_iterations = 1;
+        config.position_iterations = 1;
+        config.budget_ms = 2.0f;
+        assert(world.set_step_config(config));
+        const PhysicsStepConfig applied = world.step_config();
+        assert(applied.sub_steps == 16 && applied.velocity_iterations == 1 && applied.budget_ms == 2.0f);
+        assert(world.quality_level() == 0);
+        world.step();
+        assert(world.quality_level() <= 15);
+    }
+
+    return 0;
+}
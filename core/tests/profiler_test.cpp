@@ -0,0 +1,193 @@
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "profiler/Profiler.hpp"
+
+using miyabi::profiler::CounterReport;
+using miyabi::profiler::Profiler;
+using miyabi::profiler::ScopeReport;
+using miyabi::profiler::ScopeTimer;
+
+namespace {
+const ScopeReport* find_scope(const std::vector<ScopeReport>& reports, const std::string& thread, const std::string& path) {
+    for (const ScopeReport& report : reports) {
+        if (report.thread == thread && report.path == path) {
+            return &report;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+int main() {
+    Profiler& profiler = Profiler::instance();
+
+    {
+        // Nested scopes form a per-thread tree; repeated calls aggregate.
+        for (int frame = 0; frame < 3; ++frame) {
+            ScopeTimer frame_scope("Frame");
+            {
+                ScopeTimer update_scope("Update");
+            }
+            {
+                ScopeTimer render_scope("Render");
+                ScopeTimer pass_scope("Pass");
+            }
+        }
+        std::thread worker([] {
+            miyabi::profiler::set_thread_name("worker");
+            ScopeTimer job_scope("Job");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        });
+        worker.join();
+        profiler.collect();
+
+        const std::vector<ScopeReport> reports = profiler.report();
+        const ScopeReport* frame = find_scope(reports, "main", "Frame");
+        const ScopeReport* pass = find_scope(reports, "main", "Frame/Render/Pass");
+        const ScopeReport* job = find_scope(reports, "worker", "Job");
+        assert(frame && frame->depth == 0 && frame->window.iterations == 3);
+        assert(frame->last_collect_calls == 3);
+        assert(pass && pass->depth == 2 && pass->window.iterations == 3);
+        assert(find_scope(reports, "main", "Frame/Update"));
+        assert(job && job->window.iterations == 1);
+        // Calibrated ticks should land near the 2 ms the job slept.
+        assert(job->window.max_ms > 1.0 && job->window.max_ms < 1000.0);
+        // Parents come before their children.
+        assert(frame < pass);
+
+        profiler.collect();
+        assert(find_scope(profiler.report(), "main", "Frame")->last_collect_calls == 0);
+    }
+
+    {
+        // A full ring drops new scopes but always keeps open scopes balanced.
+        const uint64_t dropped_before = profiler.dropped_events();
+        {
+            ScopeTimer outer("Outer");
+            for (uint64_t i = 0; i < miyabi::profiler::ThreadEventRing::CAPACITY; ++i) {
+                ScopeTimer inner("Inner");
+            }
+        }
+        profiler.collect();
+        assert(profiler.dropped_events() > dropped_before);
+        const std::vector<ScopeReport> reports = profiler.report();
+        assert(find_scope(reports, "main", "Outer")->last_collect_calls == 1);
+        assert(find_scope(reports, "main", "Outer/Inner")->last_collect_calls > 0);
+
+        {
+            ScopeTimer after("After");
+        }
+        profiler.collect();
+        assert(find_scope(profiler.report(), "main", "After")->depth == 0);
+    }
+
+    {
+        // Counters keep their latest value; equal names share one counter.
+        profiler.set_counter("Level", 1.0);
+        const std::string level_name = "Level";
+        profiler.set_counter(level_name.c_str(), 3.0);
+        const std::vector<CounterReport> counters = profiler.counters();
+        assert(counters.size() == 1);
+        assert(counters[0].name == "Level" && counters[0].value == 3.0);
+    }
+
+    {
+        // A capture records the next N collects from every thread as Chrome
+        // trace events, then writes the file and stops.
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "miyabi_profiler_test" / "trace.json";
+        std::filesystem::remove(path);
+        profiler.set_counter("Quality", 0.0);
+        assert(profiler.start_capture(2, path.string()));
+        assert(!profiler.start_capture(2, path.string()));
+        for (int frame = 0; frame < 2; ++frame) {
+            assert(profiler.capturing());
+            {
+                ScopeTimer frame_scope("Frame");
+                ScopeTimer render_scope("Render");
+            }
+            profiler.set_counter("Quality", static_cast<double>(frame + 1));
+            std::thread worker([] {
+                miyabi::profiler::set_thread_name("worker");
+                ScopeTimer job_scope("Job");
+            });
+            worker.join();
+            profiler.collect();
+        }
+        assert(!profiler.capturing());
+
+        std::ifstream in(path);
+        assert(in);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        const std::string trace = contents.str();
+        assert(trace.find("\"traceEvents\"") != std::string::npos);
+        assert(trace.find("\"args\":{\"name\":\"worker\"}") != std::string::npos);
+        assert(trace.find("\"name\":\"Render\"") != std::string::npos);
+        assert(trace.find("\"name\":\"Job\"") != std::string::npos);
+        assert(trace.find("Frame/Render") == std::string::npos);
+        assert(trace.find("\"ph\":\"C\"") != std::string::npos);
+        assert(trace.find("\"name\":\"Quality\",\"args\":{\"value\":2.000}") != std::string::npos);
+        std::filesystem::remove_all(path.parent_path());
+    }
+
+    {
+        // An exited thread's ring is reused once collect() has drained it.
+        using miyabi::profiler::ThreadEventRing;
+        ThreadEventRing* first = nullptr;
+        ThreadEventRing* second = nullptr;
+        ThreadEventRing* third = nullptr;
+        std::thread([&first] {
+            ScopeTimer scope("Short");
+            first = miyabi::profiler::current_thread_ring();
+        }).join();
+        std::thread([&second] {
+            second = miyabi::profiler::current_thread_ring();
+        }).join();
+        assert(second != first);
+        const size_t threads_before = profiler.report().size();
+        profiler.collect();
+        std::thread([&third] {
+            third = miyabi::profiler::current_thread_ring();
+        }).join();
+        assert(third == first || third == second);
+        assert(third->thread_name.rfind("thread-", 0) == 0);
+        assert(profiler.report().size() >= threads_before);
+    }
+
+    {
+        // Cost of one scope against the two timestamp reads it must make;
+        // the bounds are loose (unoptimized builds, shared machines) and
+        // only catch gross regressions such as a syscall or lookup per scope.
+        constexpr int iterations = 4000;
+        uint64_t sink = 0;
+        const auto clock_start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink += miyabi::profiler::now_ticks();
+            sink += miyabi::profiler::now_ticks();
+        }
+        const double clock_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - clock_start).count() / iterations;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            ScopeTimer bench("Bench");
+        }
+        const double scope_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+        profiler.collect();
+        std::cout << "[profile] scope_cost_ns=" << scope_ns
+                  << " ticks_ns=" << clock_ns
+                  << " bookkeeping_ns=" << scope_ns - clock_ns
+                  << " sink=" << (sink & 1) << std::endl;
+        assert(scope_ns - clock_ns < 250.0);
+        assert(scope_ns < 2000.0);
+    }
+
+    return 0;
+}
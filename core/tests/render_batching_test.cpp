@@ -87,6 +87,46 @@ int main() {
     assert(batches[3].start_index == 5);
     assert(batches[3].instance_count == 2);
 
+    {
+        // Render state outranks shader, shader outranks texture.
+        assert(make_material_sort_key(1, 9, 9, 9) < make_material_sort_key(2, 1, 1, 1));
+        assert(make_material_sort_key(1, 1, 9, 9) < make_material_sort_key(1, 2, 1, 1));
+        assert(make_material_sort_key(1, 1, 1, 9) < make_material_sort_key(1, 1, 2, 1));
+        assert(make_material_sort_key(0, 0, 0, 3) != make_material_sort_key(0, 0, 0, 4));
+    }
+
+    {
+        // Material 3 shares material 1's shader, so it is drawn before
+        // material 2 even though its id is larger. Unknown ids go last.
+        const std::vector<uint64_t> sort_keys = {
+            0,
+            make_material_sort_key(0, 1, 0, 1),
+            make_material_sort_key(0, 2, 0, 2),
+            make_material_sort_key(0, 1, 0, 3),
+        };
+        std::vector<RenderableObject> keyed = {
+            make_renderable(1, 1, 2),
+            make_renderable(1, 1, 9),
+            make_renderable(1, 2, 3),
+            make_renderable(1, 1, 1),
+            make_renderable(1, 1, 3),
+        };
+        sort_renderables_by_material_key(keyed, sort_keys);
+        const std::vector<std::pair<uint32_t, uint32_t>> expected_keyed_order = {
+            {1, 1},
+            {3, 1},
+            {3, 2},
+            {2, 1},
+            {9, 1},
+        };
+        assert(keyed.size() == expected_keyed_order.size());
+        for (size_t i = 0; i < keyed.size(); ++i) {
+            assert(keyed[i].material_id == expected_keyed_order[i].first);
+            assert(keyed[i].mesh_id == expected_keyed_order[i].second);
+        }
+        assert(build_material_mesh_batches(keyed).size() == 5);
+    }
+
     std::vector<RenderableObject> empty_renderables;
     const std::vector<MaterialMeshBatch> empty_batches =
         build_material_mesh_batches(empty_renderables);
@@ -0,0 +1,45 @@
+#include <cassert>
+#include <string>
+
+#include "renderer/ShaderPermutation.hpp"
+
+int main() {
+    {
+        assert(build_shader_feature_defines(SHADER_FEATURE_NONE).empty());
+        assert(build_shader_feature_defines(SHADER_FEATURE_LIGHTING) == "#define MIYABI_LIGHTING 1\n");
+        // Bit order, independent of how the mask was built.
+        assert(build_shader_feature_defines(SHADER_FEATURE_ALPHA_TEST | SHADER_FEATURE_LIGHTING) ==
+               "#define MIYABI_LIGHTING 1\n#define MIYABI_ALPHA_TEST 1\n");
+    }
+
+    {
+        // No defines: the source is untouched.
+        const std::string source = "#version 330 core\nvoid main() {}\n";
+        assert(inject_shader_defines(source, "") == source);
+    }
+
+    {
+        // #version stays first; the line after it is renumbered back to 2.
+        const std::string source = "#version 330 core\nout vec4 FragColor;\n";
+        const std::string injected = inject_shader_defines(source, "#define MIYABI_LIGHTING 1\n");
+        assert(injected ==
+               "#version 330 core\n#define MIYABI_LIGHTING 1\n#line 2\nout vec4 FragColor;\n");
+    }
+
+    {
+        // Leading comment lines shift the #version line; "#version" inside a
+        // comment does not count.
+        const std::string source = "// see #version notes\n#version 330 core\nvoid main() {}\n";
+        const std::string injected = inject_shader_defines(source, "#define MIYABI_ALPHA_TEST 1\n");
+        assert(injected ==
+               "// see #version notes\n#version 330 core\n#define MIYABI_ALPHA_TEST 1\n#line 3\nvoid main() {}\n");
+    }
+
+    {
+        // Without a #version line the block is prepended.
+        const std::string injected = inject_shader_defines("void main() {}\n", "#define MIYABI_LIGHTING 1\n");
+        assert(injected == "#define MIYABI_LIGHTING 1\n#line 1\nvoid main() {}\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "profiler/TimingStats.hpp"
+
+using miyabi::profiler::TimingSamples;
+using miyabi::profiler::TimingSummary;
+using miyabi::profiler::summarize_timings;
+
+namespace {
+bool near(double lhs, double rhs) {
+    return std::fabs(lhs - rhs) < 1e-9;
+}
+} // namespace
+
+int main() {
+    {
+        const TimingSummary empty = summarize_timings({});
+        assert(empty.iterations == 0);
+        assert(empty.avg_ms == 0.0 && empty.p95_ms == 0.0 && empty.max_ms == 0.0);
+        assert(empty.p50_ms == 0.0 && empty.p99_ms == 0.0);
+    }
+
+    {
+        // Nearest rank, as in logic/src/perf.rs: ceil(0.95 * 20) = 19th value,
+        // ceil(0.5 * 20) = 10th, ceil(0.99 * 20) = 20th.
+        std::vector<double> samples;
+        for (int i = 20; i >= 1; --i) {
+            samples.push_back(static_cast<double>(i));
+        }
+        const TimingSummary summary = summarize_timings(samples);
+        assert(summary.iterations == 20);
+        assert(near(summary.avg_ms, 10.5));
+        assert(near(summary.p50_ms, 10.0));
+        assert(near(summary.p95_ms, 19.0));
+        assert(near(summary.p99_ms, 20.0));
+        assert(near(summary.min_ms, 1.0));
+        assert(near(summary.max_ms, 20.0));
+    }
+
+    {
+        // The ring keeps only the newest `capacity` samples.
+        TimingSamples ring(3);
+        assert(ring.last() == 0.0);
+        ring.add(1.0);
+        ring.add(2.0);
+        assert(ring.size() == 2);
+        assert(near(ring.summarize().avg_ms, 1.5));
+        ring.add(3.0);
+        ring.add(10.0);
+        assert(ring.size() == 3);
+        assert(near(ring.last(), 10.0));
+        const TimingSummary summary = ring.summarize();
+        assert(near(summary.min_ms, 2.0));
+        assert(near(summary.max_ms, 10.0));
+        ring.clear();
+        assert(ring.size() == 0);
+        assert(ring.summarize().iterations == 0);
+    }
+
+    return 0;
+}
@@ -39,6 +39,28 @@ pub struct TextCommandSlice {
     len: usize,
 }
 
+/// Borrowed UTF-8 bytes owned by Rust. Not NUL-terminated; `len` is in bytes.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct MiyabiStringView {
+    ptr: *const c_char,
+    len: usize,
+}
+
+impl MiyabiStringView {
+    const EMPTY: MiyabiStringView = MiyabiStringView {
+        ptr: ptr::null(),
+        len: 0,
+    };
+
+    fn borrow(value: &str) -> Self {
+        MiyabiStringView {
+            ptr: value.as_ptr() as *const c_char,
+            len: value.len(),
+        }
+    }
+}
+
 #[repr(C)]
 pub struct MiyabiVTable {
     abi_version: u32,
@@ -57,9 +79,12 @@ pub struct MiyabiVTable {
     get_text_commands: extern "C" fn(*mut Game) -> TextCommandSlice,
     get_text_command_text_cstring: extern "C" fn(*const ffi::TextCommand) -> *mut c_char,
     free_cstring: extern "C" fn(*mut c_char),
+    // 1.1: borrowed views; the *_cstring entries above remain as a shim.
+    get_asset_command_path_view: extern "C" fn(*const ffi::AssetCommand) -> MiyabiStringView,
+    get_text_command_text_view: extern "C" fn(*const ffi::TextCommand) -> MiyabiStringView,
 }
 
-const MIYABI_ABI_VERSION: u32 = (1u32 << 16) | (0u32 << 8);
+const MIYABI_ABI_VERSION: u32 = (1u32 << 16) | (1u32 << 8);
 
 #[no_mangle]
 pub extern "C" fn get_miyabi_vtable() -> MiyabiVTable {
@@ -80,6 +105,8 @@ pub extern "C" fn get_miyabi_vtable() -> MiyabiVTable {
         get_text_commands,
         get_text_command_text_cstring,
         free_cstring,
+        get_asset_command_path_view,
+        get_text_command_text_view,
     }
 }
 
@@ -186,10 +213,146 @@ pub mod ffi {
         pub color: Vec4,
     }
 
-    #[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, Serialize, Deserialize)]
+    #[derive(Debug, Clone, Copy, PartialEq, Eq)]
+    pub enum BodyKind {
+        Static,
+        Kinematic,
+        Dynamic,
+    }
+
+    #[derive(Debug, Clone, Copy, PartialEq, Eq)]
+    pub enum BodyShapeType {
+        Box,
+        Circle,
+        Polygon,
+    }
+
+    // Body creation parameters for create_bodies (meters, radians). Box uses
+    // half_extents, Circle uses radius, Polygon reads vertex_count points
+    // from vertex_offset in the vertices slice passed alongside. Sizes must
+    // be finite and positive, density and friction finite and >= 0; other
+    // descriptors are rejected with id 0. Bodies only collide with bodies
+    // in the same physics partition. Sensors report overlaps but do not
+    // collide. Bullets get continuous collision against other dynamic
+    // bodies (needs PhysicsStepConfig::continuous).
+    #[derive(Debug, Clone, Copy, PartialEq)]
+    pub struct BodyDesc {
+        pub kind: BodyKind,
+        pub shape: BodyShapeType,
+        pub position: Vec2,
+        pub angle: f32,
+        pub half_extents: Vec2,
+        pub radius: f32,
+        pub vertex_offset: u32,
+        pub vertex_count: u32,
+        pub density: f32,
+        pub friction: f32,
+        pub restitution: f32,
+        pub category_bits: u16,
+        pub mask_bits: u16,
+        pub group_index: i16,
+        // Partition the body is stepped in (< MIYABI_PHYSICS_PARTITIONS).
+        // Bodies in different partitions never collide or report contacts,
+        // even when they overlap, so only split regions that cannot touch.
+        pub partition: u32,
+        pub sensor: bool,
+        pub bullet: bool,
+    }
+
+    // Physics step settings. time_step is simulated seconds per engine step,
+    // split into sub_steps solver passes. budget_ms > 0 enables the adaptive
+    // mode, which lowers sub-steps and then iterations while steps run over
+    // budget; 0 keeps the configured quality.
+    #[derive(Debug, Clone, Copy, PartialEq)]
+    pub struct PhysicsStepConfig {
+        pub time_step: f32,
+        pub velocity_iterations: i32,
+        pub position_iterations: i32,
+        pub sub_steps: u32,
+        pub continuous: bool,
+        pub budget_ms: f32,
+    }
+
+    #[derive(Debug, Clone, Copy, PartialEq, Eq)]
+    pub enum CollisionEventKind {
+        Begin,
+        End,
+        SensorBegin,
+        SensorEnd,
+    }
+
+    // Contact event from the last physics step (meters). Begin events carry
+    // the averaged world contact point, the normal from bodyA to bodyB, the
+    // closing speed at first touch and the largest normal/tangent impulse
+    // the solver applied in that step; other kinds leave them zero. Sensor
+    // events put the sensor's body in bodyA.
+    #[derive(Debug, Clone, Copy, PartialEq)]
     pub struct CollisionEvent {
         pub bodyA: u64,
         pub bodyB: u64,
+        pub kind: CollisionEventKind,
+        pub point: Vec2,
+        pub normal: Vec2,
+        pub approach_speed: f32,
+        pub normal_impulse: f32,
+        pub tangent_impulse: f32,
+    }
+
+    // Per-body state exported in bulk after each physics step (meters, radians).
+    #[derive(Debug, Clone, Copy, PartialEq, Default)]
+    pub struct BodyState {
+        pub id: u64,
+        pub position: Vec2,
+        pub angle: f32,
+        pub velocity: Vec2,
+    }
+
+    // Ray from origin to origin + translation (meters). Only fixtures whose
+    // category bits intersect mask_bits are considered.
+    #[derive(Debug, Clone, Copy, PartialEq)]
+    pub struct RayCastQuery {
+        pub origin: Vec2,
+        pub translation: Vec2,
+        pub mask_bits: u16,
+    }
+
+    // Box (half_extents) or Circle (radius) swept from position to
+    // position + translation.
+    #[derive(Debug, Clone, Copy, PartialEq)]
+    pub struct ShapeCastQuery {
+        pub shape: BodyShapeType,
+        pub position: Vec2,
+        pub angle: f32,
+        pub half_extents: Vec2,
+        pub radius: f32,
+        pub translation: Vec2,
+        pub mask_bits: u16,
+    }
+
+    #[derive(Debug, Clone, Copy, PartialEq)]
+    pub struct AabbQuery {
+        pub lower: Vec2,
+        pub upper: Vec2,
+        pub mask_bits: u16,
+    }
+
+    // Closest hit of one ray or shape cast; body is 0 on a miss. fraction is
+    // the hit's position along the translation (0..=1).
+    #[derive(Debug, Clone, Copy, PartialEq, Default)]
+    pub struct QueryHit {
+        pub body: u64,
+        pub point: Vec2,
+        pub normal: Vec2,
+        pub fraction: f32,
+    }
+
+    // Body ids of one AABB query: out_ids[offset..offset + count]. found also
+    // counts overlaps that did not fit in out_ids.
+    #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+    pub struct QueryRange {
+        pub offset: u32,
+        pub count: u32,
+        pub found: u32,
     }
 
     unsafe extern "C++" {
@@ -207,8 +370,26 @@ pub mod ffi {
         // Physics
         fn create_dynamic_box_body(x: f32, y: f32, width: f32, height: f32) -> u64;
         fn create_static_box_body(x: f32, y: f32, width: f32, height: f32) -> u64;
+        fn destroy_body(id: u64) -> bool;
+        fn create_bodies(descs: &[BodyDesc], vertices: &[Vec2], out_ids: &mut [u64]) -> usize;
+        fn destroy_bodies(ids: &[u64]) -> usize;
         fn get_body_position(id: u64) -> Vec2;
         fn get_collision_events() -> &'static [CollisionEvent];
+        fn get_body_states() -> &'static [BodyState];
+        fn fill_body_states(ids: &[u64], out: &mut [BodyState]) -> usize;
+        fn get_moved_body_states() -> &'static [BodyState];
+        fn raycast_bodies(queries: &[RayCastQuery], out_hits: &mut [QueryHit]) -> usize;
+        fn shape_cast_bodies(queries: &[ShapeCastQuery], out_hits: &mut [QueryHit]) -> usize;
+        fn query_aabb_bodies(
+            queries: &[AabbQuery],
+            out_ids: &mut [u64],
+            out_ranges: &mut [QueryRange],
+        ) -> usize;
+        fn save_physics_snapshot() -> &'static [u8];
+        fn restore_physics_snapshot(data: &[u8]) -> bool;
+        fn set_physics_step_config(config: &PhysicsStepConfig) -> bool;
+        fn get_physics_step_config() -> PhysicsStepConfig;
+        fn set_body_bullet(id: u64, bullet: bool) -> bool;
 
         #[cfg(feature = "performance_test")]
         fn get_performance_test_sprite_count() -> u32;
@@ -220,6 +401,80 @@ pub mod ffi {
     }
 }
 
+impl ffi::RayCastQuery {
+    pub fn new(origin: ffi::Vec2, translation: ffi::Vec2) -> Self {
+        Self {
+            origin,
+            translation,
+            mask_bits: 0xFFFF,
+        }
+    }
+}
+
+impl ffi::AabbQuery {
+    pub fn new(lower: ffi::Vec2, upper: ffi::Vec2) -> Self {
+        Self {
+            lower,
+            upper,
+            mask_bits: 0xFFFF,
+        }
+    }
+}
+
+impl Default for ffi::PhysicsStepConfig {
+    /// The engine defaults: 60 Hz, 6 velocity and 2 position iterations,
+    /// one sub-step, continuous collision on, no budget.
+    fn default() -> Self {
+        Self {
+            time_step: 1.0 / 60.0,
+            velocity_iterations: 6,
+            position_iterations: 2,
+            sub_steps: 1,
+            continuous: true,
+            budget_ms: 0.0,
+        }
+    }
+}
+
+impl ffi::BodyDesc {
+    /// Box with the fixture defaults of the single-body bridge calls
+    /// (dynamic: density 1, friction 0.3; otherwise density 0, friction 0.2).
+    pub fn new_box(kind: ffi::BodyKind, x: f32, y: f32, width: f32, height: f32) -> Self {
+        let dynamic = kind == ffi::BodyKind::Dynamic;
+        Self {
+            kind,
+            shape: ffi::BodyShapeType::Box,
+            position: ffi::Vec2 { x, y },
+            angle: 0.0,
+            half_extents: ffi::Vec2 {
+                x: width / 2.0,
+                y: height / 2.0,
+            },
+            radius: 0.0,
+            vertex_offset: 0,
+            vertex_count: 0,
+            density: if dynamic { 1.0 } else { 0.0 },
+            friction: if dynamic { 0.3 } else { 0.2 },
+            restitution: 0.0,
+            category_bits: 0x0001,
+            mask_bits: 0xFFFF,
+            group_index: 0,
+            partition: 0,
+            sensor: false,
+            bullet: false,
+        }
+    }
+
+    pub fn new_circle(kind: ffi::BodyKind, x: f32, y: f32, radius: f32) -> Self {
+        Self {
+            shape: ffi::BodyShapeType::Circle,
+            half_extents: ffi::Vec2::default(),
+            radius,
+            ..Self::new_box(kind, x, y, 0.0, 0.0)
+        }
+    }
+}
+
 #[cfg(feature = "performance_test")]
 fn get_sprite_count() -> u32 {
     ffi::get_performance_test_sprite_count()
@@ -228,9 +483,15 @@ fn get_sprite_count() -> u32 {
 #[cfg(test)]
 mod runtime_bridge {
     use super::{ffi, AtomicBool, Ordering};
+    use std::cell::Cell;
 
     static PENDING_WINDOW_CLOSE: AtomicBool = AtomicBool::new(false);
 
+    thread_local! {
+        static STEP_CONFIG: Cell<ffi::PhysicsStepConfig> =
+            Cell::new(ffi::PhysicsStepConfig::default());
+    }
+
     pub fn play_sound(_path: &str) {}
 
     pub fn play_bgm(_path: &str, _looped: bool) {}
@@ -249,21 +510,87 @@ mod runtime_bridge {
         PENDING_WINDOW_CLOSE.swap(false, Ordering::AcqRel)
     }
 
-    pub fn create_dynamic_box_body(_x: f32, _y: f32, _width: f32, _height: f32) -> u64 {
+    pub fn create_bodies(
+        descs: &[ffi::BodyDesc],
+        _vertices: &[ffi::Vec2],
+        out_ids: &mut [u64],
+    ) -> usize {
+        for id in out_ids.iter_mut().take(descs.len()) {
+            *id = 0;
+        }
         0
     }
 
-    pub fn create_static_box_body(_x: f32, _y: f32, _width: f32, _height: f32) -> u64 {
+    pub fn destroy_bodies(_ids: &[u64]) -> usize {
         0
     }
 
-    pub fn get_body_position(_id: u64) -> ffi::Vec2 {
-        ffi::Vec2::default()
+    pub fn get_collision_events() -> &'static [ffi::CollisionEvent] {
+        &[]
     }
 
-    pub fn get_collision_events() -> &'static [ffi::CollisionEvent] {
+    pub fn get_moved_body_states() -> &'static [ffi::BodyState] {
+        &[]
+    }
+
+    pub fn raycast_bodies(queries: &[ffi::RayCastQuery], out_hits: &mut [ffi::QueryHit]) -> usize {
+        for hit in out_hits.iter_mut().take(queries.len()) {
+            *hit = ffi::QueryHit::default();
+        }
+        0
+    }
+
+    pub fn shape_cast_bodies(
+        queries: &[ffi::ShapeCastQuery],
+        out_hits: &mut [ffi::QueryHit],
+    ) -> usize {
+        for hit in out_hits.iter_mut().take(queries.len()) {
+            *hit = ffi::QueryHit::default();
+        }
+        0
+    }
+
+    pub fn query_aabb_bodies(
+        queries: &[ffi::AabbQuery],
+        _out_ids: &mut [u64],
+        out_ranges: &mut [ffi::QueryRange],
+    ) -> usize {
+        for range in out_ranges.iter_mut().take(queries.len()) {
+            *range = ffi::QueryRange::default();
+        }
+        0
+    }
+
+    pub fn save_physics_snapshot() -> &'static [u8] {
         &[]
     }
+
+    pub fn restore_physics_snapshot(_data: &[u8]) -> bool {
+        true
+    }
+
+    // Same validation as PhysicsManager::set_step_config.
+    pub fn set_physics_step_config(config: &ffi::PhysicsStepConfig) -> bool {
+        let valid = config.time_step.is_finite()
+            && config.time_step > 0.0
+            && config.velocity_iterations >= 1
+            && config.position_iterations >= 1
+            && (1..=16).contains(&config.sub_steps)
+            && config.budget_ms.is_finite()
+            && config.budget_ms >= 0.0;
+        if valid {
+            STEP_CONFIG.with(|step_config| step_config.set(*config));
+        }
+        valid
+    }
+
+    pub fn get_physics_step_config() -> ffi::PhysicsStepConfig {
+        STEP_CONFIG.with(Cell::get)
+    }
+
+    pub fn set_body_bullet(_id: u64, _bullet: bool) -> bool {
+        false
+    }
 }
 
 #[cfg(not(test))]
@@ -298,21 +625,64 @@ mod runtime_bridge {
         ffi::consume_pending_window_close_request()
     }
 
-    pub fn create_dynamic_box_body(x: f32, y: f32, width: f32, height: f32) -> u64 {
-        ffi::create_dynamic_box_body(x, y, width, height)
-    }
-
-    pub fn create_static_box_body(x: f32, y: f32, width: f32, height: f32) -> u64 {
-        ffi::create_static_box_body(x, y, width, height)
+    pub fn create_bodies(
+        descs: &[ffi::BodyDesc],
+        vertices: &[ffi::Vec2],
+        out_ids: &mut [u64],
+    ) -> usize {
+        ffi::create_bodies(descs, vertices, out_ids)
     }
 
-    pub fn get_body_position(id: u64) -> ffi::Vec2 {
-        ffi::get_body_position(id)
+    pub fn destroy_bodies(ids: &[u64]) -> usize {
+        ffi::destroy_bodies(ids)
     }
 
     pub fn get_collision_events() -> &'static [ffi::CollisionEvent] {
         ffi::get_collision_events()
     }
+
+    pub fn get_moved_body_states() -> &'static [ffi::BodyState] {
+        ffi::get_moved_body_states()
+    }
+
+    pub fn raycast_bodies(queries: &[ffi::RayCastQuery], out_hits: &mut [ffi::QueryHit]) -> usize {
+        ffi::raycast_bodies(queries, out_hits)
+    }
+
+    pub fn shape_cast_bodies(
+        queries: &[ffi::ShapeCastQuery],
+        out_hits: &mut [ffi::QueryHit],
+    ) -> usize {
+        ffi::shape_cast_bodies(queries, out_hits)
+    }
+
+    pub fn query_aabb_bodies(
+        queries: &[ffi::AabbQuery],
+        out_ids: &mut [u64],
+        out_ranges: &mut [ffi::QueryRange],
+    ) -> usize {
+        ffi::query_aabb_bodies(queries, out_ids, out_ranges)
+    }
+
+    pub fn save_physics_snapshot() -> &'static [u8] {
+        ffi::save_physics_snapshot()
+    }
+
+    pub fn restore_physics_snapshot(data: &[u8]) -> bool {
+        ffi::restore_physics_snapshot(data)
+    }
+
+    pub fn set_physics_step_config(config: &ffi::PhysicsStepConfig) -> bool {
+        ffi::set_physics_step_config(config)
+    }
+
+    pub fn get_physics_step_config() -> ffi::PhysicsStepConfig {
+        ffi::get_physics_step_config()
+    }
+
+    pub fn set_body_bullet(id: u64, bullet: bool) -> bool {
+        ffi::set_body_bullet(id, bullet)
+    }
 }
 
 // Main game state
@@ -644,6 +1014,10 @@ pub struct InternalWorld {
     pub entities: HashMap<Entity, (usize, usize)>,
     pub archetypes: Vec<Archetype>,
     pub next_entity: u64,
+    // Bumped whenever entities are added or removed, so caches of entity
+    // rows know when to rebuild.
+    #[serde(skip)]
+    pub structure_version: u64,
 }
 
 impl InternalWorld {
@@ -652,6 +1026,7 @@ impl InternalWorld {
             entities: HashMap::new(),
             archetypes: Vec::new(),
             next_entity: 0,
+            structure_version: 0,
         }
     }
 
@@ -729,9 +1104,38 @@ impl InternalWorld {
         self.next_entity += 1;
         self.entities
             .insert(entity, (archetype_idx, entity_idx_in_archetype));
+        self.structure_version += 1;
         entity
     }
 
+    pub fn physics_body_ids(&self) -> Vec<u64> {
+        let mut ids = Vec::new();
+        for archetype in &self.archetypes {
+            if let Some(storage) = archetype.storage.get(&ComponentType::Physics) {
+                let bodies = storage.downcast_ref::<Vec<PhysicsBody>>().unwrap();
+                ids.extend(bodies[..archetype.entity_count].iter().map(|body| body.id));
+            }
+        }
+        ids
+    }
+
+    /// Maps the body id of every entity with Physics and Transform to its
+    /// (archetype index, row). Valid until `structure_version` changes.
+    pub fn fill_physics_rows(&self, rows: &mut HashMap<u64, (usize, usize)>) {
+        rows.clear();
+        for (archetype_idx, archetype) in self.archetypes.iter().enumerate() {
+            if !archetype.types.contains(&ComponentType::Transform) {
+                continue;
+            }
+            if let Some(storage) = archetype.storage.get(&ComponentType::Physics) {
+                let bodies = storage.downcast_ref::<Vec<PhysicsBody>>().unwrap();
+                for (row, body) in bodies[..archetype.entity_count].iter().enumerate() {
+                    rows.insert(body.id, (archetype_idx, row));
+                }
+            }
+        }
+    }
+
     pub fn clear_entities_of_component(&mut self, component_type: ComponentType) {
         // This is a simplified and potentially slow implementation.
         // A more robust ECS would have faster ways to do this.
@@ -754,6 +1158,7 @@ impl InternalWorld {
             // This needs to be addressed in a future refactoring of the ECS.
             self.entities.remove(&entity);
         }
+        self.structure_version += 1;
 
         // Also clear the archetypes that are now empty
         for archetype in self.archetypes.iter_mut() {
@@ -1099,6 +1504,12 @@ pub struct Game {
     pub text_commands: Vec<ffi::TextCommand>,
     #[serde(skip)]
     pub collision_events: Vec<ffi::CollisionEvent>,
+    // Body id -> (archetype, row) for the physics sync, rebuilt only when
+    // the world's structure_version differs from physics_rows_version.
+    #[serde(skip)]
+    pub physics_rows: HashMap<u64, (usize, usize)>,
+    #[serde(skip)]
+    pub physics_rows_version: Option<u64>,
 
     pub hp: i32,
     pub survival_time_sec: f32,
@@ -1235,6 +1646,8 @@ impl Game {
             asset_commands: Vec::new(),
             text_commands: Vec::new(),
             collision_events: Vec::new(),
+            physics_rows: HashMap::new(),
+            physics_rows_version: None,
             hp: 3,
             survival_time_sec: 0.0,
             avoid_count: 0,
@@ -1792,7 +2205,19 @@ impl Game {
             .clear_entities_of_component(ComponentType::Button);
     }
 
+    // Destroys the engine-side bodies before their entities are dropped, so
+    // the physics world does not keep bodies nobody references.
+    fn clear_physics_entities(&mut self) {
+        let body_ids = self.world.physics_body_ids();
+        if !body_ids.is_empty() {
+            runtime_bridge::destroy_bodies(&body_ids);
+        }
+        self.world
+            .clear_entities_of_component(ComponentType::Physics);
+    }
+
     fn clear_runtime_world(&mut self) {
+        self.clear_physics_entities();
         for component_type in [
             ComponentType::Transform,
             ComponentType::Velocity,
@@ -2866,8 +3291,7 @@ impl Game {
     fn setup_sprite_stress_test(&mut self) {
         self.world
             .clear_entities_of_component(ComponentType::Button);
-        self.world
-            .clear_entities_of_component(ComponentType::Physics);
+        self.clear_physics_entities();
 
         let mut rng = rand::thread_rng();
         let player_texture = self.asset_server.load_texture("assets/player.png");
@@ -2917,6 +3341,7 @@ impl Game {
     }
 
     fn setup_physics_stress_test(&mut self) {
+        self.clear_physics_entities();
         self.world
             .clear_entities_of_component(ComponentType::Button);
         self.world
@@ -2962,23 +3387,17 @@ impl Game {
             ),
         ];
 
+        // Describe every body first and create them with one bridge call.
+        let mut boxes: Vec<(f32, f32, f32, f32, u32)> = Vec::with_capacity(walls.len() + 500);
+        let mut descs: Vec<ffi::BodyDesc> = Vec::with_capacity(walls.len() + 500);
         for (x, y, w, h) in walls {
-            let body_id =
-                runtime_bridge::create_static_box_body(x / PPM, y / PPM, w / PPM, h / PPM);
-            self.world.spawn((
-                ffi::Transform {
-                    position: ffi::Vec3 { x, y, z: 0.0 },
-                    rotation: ffi::Vec3 {
-                        x: 0.0,
-                        y: 0.0,
-                        z: 0.0,
-                    },
-                    scale: ffi::Vec3 { x: w, y: h, z: 1.0 },
-                },
-                PhysicsBody { id: body_id },
-                Material {
-                    texture_handle: ground_texture,
-                },
+            boxes.push((x, y, w, h, ground_texture));
+            descs.push(ffi::BodyDesc::new_box(
+                ffi::BodyKind::Static,
+                x / PPM,
+                y / PPM,
+                w / PPM,
+                h / PPM,
             ));
         }
 
@@ -2991,13 +3410,20 @@ impl Game {
             let y = rng.gen_range(
                 (WALL_THICKNESS + box_size)..(SCREEN_HEIGHT - WALL_THICKNESS - box_size),
             );
-
-            let body_id = runtime_bridge::create_dynamic_box_body(
+            boxes.push((x, y, box_size, box_size, box_texture));
+            descs.push(ffi::BodyDesc::new_box(
+                ffi::BodyKind::Dynamic,
                 x / PPM,
                 y / PPM,
                 box_size / PPM,
                 box_size / PPM,
-            );
+            ));
+        }
+
+        let mut body_ids = vec![0_u64; descs.len()];
+        runtime_bridge::create_bodies(&descs, &[], &mut body_ids);
+
+        for ((x, y, w, h, texture_handle), body_id) in boxes.into_iter().zip(body_ids) {
             self.world.spawn((
                 ffi::Transform {
                     position: ffi::Vec3 { x, y, z: 0.0 },
@@ -3006,16 +3432,10 @@ impl Game {
                         y: 0.0,
                         z: 0.0,
                     },
-                    scale: ffi::Vec3 {
-                        x: box_size,
-                        y: box_size,
-                        z: 1.0,
-                    },
+                    scale: ffi::Vec3 { x: w, y: h, z: 1.0 },
                 },
                 PhysicsBody { id: body_id },
-                Material {
-                    texture_handle: box_texture,
-                },
+                Material { texture_handle },
             ));
         }
     }
@@ -3033,8 +3453,7 @@ impl Game {
             .clear_entities_of_component(ComponentType::Button);
         self.world
             .clear_entities_of_component(ComponentType::Sprite);
-        self.world
-            .clear_entities_of_component(ComponentType::Physics);
+        self.clear_physics_entities();
     }
 
     fn update_ui_stress_test(&mut self) {
@@ -3164,32 +3583,79 @@ impl Game {
     fn sync_physics_to_render(&mut self) {
         const PPM: f32 = 50.0; // Pixels Per Meter
 
-        for archetype in &mut self.world.archetypes {
-            if archetype.types.contains(&ComponentType::Physics)
-                && archetype.types.contains(&ComponentType::Transform)
-            {
-                let mut transform_storage =
-                    archetype.storage.remove(&ComponentType::Transform).unwrap();
-                let physics_storage = archetype.storage.get(&ComponentType::Physics).unwrap();
+        // Only bodies that moved in the last step; sleeping ones cost nothing.
+        let moved = runtime_bridge::get_moved_body_states();
+        if moved.is_empty() {
+            return;
+        }
+        if self.physics_rows_version != Some(self.world.structure_version) {
+            self.world.fill_physics_rows(&mut self.physics_rows);
+            self.physics_rows_version = Some(self.world.structure_version);
+        }
 
-                let transforms = transform_storage
-                    .downcast_mut::<Vec<ffi::Transform>>()
-                    .unwrap();
-                let physics_bodies = physics_storage.downcast_ref::<Vec<PhysicsBody>>().unwrap();
+        for state in moved {
+            let Some(&(archetype_idx, row)) = self.physics_rows.get(&state.id) else {
+                continue;
+            };
+            let transforms = self.world.archetypes[archetype_idx]
+                .storage
+                .get_mut(&ComponentType::Transform)
+                .unwrap()
+                .downcast_mut::<Vec<ffi::Transform>>()
+                .unwrap();
+            let transform = &mut transforms[row];
+            transform.position.x = state.position.x * PPM;
+            transform.position.y = state.position.y * PPM;
+        }
+    }
 
-                for i in 0..archetype.entity_count {
-                    let body_id = physics_bodies[i].id;
-                    let new_pos_meters = runtime_bridge::get_body_position(body_id);
+    /// Closest hit of each ray against the physics world (meters); out_hits[i]
+    /// has body 0 on a miss. Queries past out_hits.len() are ignored.
+    /// Returns the number of hits.
+    pub fn raycast_bodies(
+        &self,
+        queries: &[ffi::RayCastQuery],
+        out_hits: &mut [ffi::QueryHit],
+    ) -> usize {
+        runtime_bridge::raycast_bodies(queries, out_hits)
+    }
 
-                    transforms[i].position.x = new_pos_meters.x * PPM;
-                    transforms[i].position.y = new_pos_meters.y * PPM;
-                }
+    /// Closest hit of each swept box or circle, like raycast_bodies.
+    pub fn shape_cast_bodies(
+        &self,
+        queries: &[ffi::ShapeCastQuery],
+        out_hits: &mut [ffi::QueryHit],
+    ) -> usize {
+        runtime_bridge::shape_cast_bodies(queries, out_hits)
+    }
 
-                archetype
-                    .storage
-                    .insert(ComponentType::Transform, transform_storage);
-            }
-        }
+    /// Ids of the bodies overlapping each AABB, packed into out_ids in query
+    /// order; out_ranges[i] locates query i's ids (see ffi::QueryRange).
+    /// Returns the number of ids written.
+    pub fn query_aabb_bodies(
+        &self,
+        queries: &[ffi::AabbQuery],
+        out_ids: &mut [u64],
+        out_ranges: &mut [ffi::QueryRange],
+    ) -> usize {
+        runtime_bridge::query_aabb_bodies(queries, out_ids, out_ranges)
+    }
+
+    /// Replaces the physics step settings (see ffi::PhysicsStepConfig).
+    /// Returns false, keeping the current settings, when a value is out of
+    /// range.
+    pub fn set_physics_step_config(&self, config: &ffi::PhysicsStepConfig) -> bool {
+        runtime_bridge::set_physics_step_config(config)
+    }
+
+    pub fn physics_step_config(&self) -> ffi::PhysicsStepConfig {
+        runtime_bridge::get_physics_step_config()
+    }
+
+    /// Continuous collision against other dynamic bodies for a fast mover.
+    /// Returns false for unknown or destroyed ids.
+    pub fn set_body_bullet(&self, id: u64, bullet: bool) -> bool {
+        runtime_bridge::set_body_bullet(id, bullet)
     }
 
     // --- Old systems to be removed or refactored ---
@@ -3268,10 +3734,11 @@ mod tests {
 
     use super::{
         ffi, runtime_bridge, save, ui, Archetype, ComponentBundle, ComponentType, Game, GameState,
-        Material, MovementPreset, RenderMesh, RunMode, SystemRegistry, ARENA_CLEAR_TIME_SEC,
-        FIXED_DT_SEC, MATERIAL_ID_LIT_TEXTURED_3D, MESH_ID_ARENA_CUBE_3D, MESH_ID_QUAD_2D,
+        InternalWorld, Material, MovementPreset, PhysicsBody, RenderMesh, RunMode, SystemRegistry,
+        ARENA_CLEAR_TIME_SEC, FIXED_DT_SEC, MATERIAL_ID_LIT_TEXTURED_3D, MESH_ID_ARENA_CUBE_3D,
+        MESH_ID_QUAD_2D,
     };
-    use std::collections::HashSet;
+    use std::collections::{HashMap, HashSet};
     use std::path::PathBuf;
     use std::time::{SystemTime, UNIX_EPOCH};
 
@@ -3581,6 +4048,195 @@ mod tests {
         );
     }
 
+    #[test]
+    fn physics_body_ids_lists_live_bodies_until_cleared() {
+        let mut world = InternalWorld::new();
+        for id in [3_u64, (1_u64 << 32) | 1] {
+            world.spawn((
+                ffi::Transform {
+                    position: ffi::Vec3 {
+                        x: 0.0,
+                        y: 0.0,
+                        z: 0.0,
+                    },
+                    rotation: ffi::Vec3 {
+                        x: 0.0,
+                        y: 0.0,
+                        z: 0.0,
+                    },
+                    scale: ffi::Vec3 {
+                        x: 1.0,
+                        y: 1.0,
+                        z: 1.0,
+                    },
+                },
+                PhysicsBody { id },
+                Material { texture_handle: 0 },
+            ));
+        }
+        assert_eq!(world.physics_body_ids(), vec![3, (1_u64 << 32) | 1]);
+
+        world.clear_entities_of_component(ComponentType::Physics);
+        assert!(world.physics_body_ids().is_empty());
+    }
+
+    #[test]
+    fn physics_rows_follow_structure_version() {
+        let mut world = InternalWorld::new();
+        let mut rows = HashMap::new();
+        let version = world.structure_version;
+        for id in [7_u64, 9] {
+            world.spawn((
+                ffi::Transform {
+                    position: ffi::Vec3 {
+                        x: 0.0,
+                        y: 0.0,
+                        z: 0.0,
+                    },
+                    rotation: ffi::Vec3 {
+                        x: 0.0,
+                        y: 0.0,
+                        z: 0.0,
+                    },
+                    scale: ffi::Vec3 {
+                        x: 1.0,
+                        y: 1.0,
+                        z: 1.0,
+                    },
+                },
+                PhysicsBody { id },
+                Material { texture_handle: 0 },
+            ));
+        }
+        assert_ne!(world.structure_version, version);
+        world.fill_physics_rows(&mut rows);
+        assert_eq!(rows.len(), 2);
+        assert_eq!(rows[&7].1, 0);
+        assert_eq!(rows[&9].1, 1);
+        assert_eq!(rows[&7].0, rows[&9].0);
+
+        let version = world.structure_version;
+        world.clear_entities_of_component(ComponentType::Physics);
+        assert_ne!(world.structure_version, version);
+        world.fill_physics_rows(&mut rows);
+        assert!(rows.is_empty());
+    }
+
+    #[test]
+    fn physics_step_config_is_validated() {
+        let game = Game::new();
+        let defaults = game.physics_step_config();
+        assert_eq!(defaults, ffi::PhysicsStepConfig::default());
+
+        let slow = ffi::PhysicsStepConfig {
+            sub_steps: 4,
+            budget_ms: 2.0,
+            ..defaults
+        };
+        assert!(game.set_physics_step_config(&slow));
+        assert_eq!(game.physics_step_config(), slow);
+
+        for invalid in [
+            ffi::PhysicsStepConfig {
+                time_step: 0.0,
+                ..defaults
+            },
+            ffi::PhysicsStepConfig {
+                sub_steps: 0,
+                ..defaults
+            },
+            ffi::PhysicsStepConfig {
+                sub_steps: 17,
+                ..defaults
+            },
+            ffi::PhysicsStepConfig {
+                velocity_iterations: 0,
+                ..defaults
+            },
+            ffi::PhysicsStepConfig {
+                budget_ms: f32::NAN,
+                ..defaults
+            },
+        ] {
+            assert!(!game.set_physics_step_config(&invalid));
+        }
+        assert_eq!(game.physics_step_config(), slow);
+        assert!(!game.set_body_bullet(1, true));
+    }
+
+    #[test]
+    fn physics_queries_miss_without_engine() {
+        let game = Game::new();
+        let origin = ffi::Vec2 { x: 0.0, y: 0.0 };
+        let reach = ffi::Vec2 { x: 1.0, y: 0.0 };
+
+        let rays = [ffi::RayCastQuery::new(origin, reach); 2];
+        let stale = ffi::QueryHit {
+            body: 5,
+            ..Default::default()
+        };
+        let mut hits = [stale; 3];
+        assert_eq!(game.raycast_bodies(&rays, &mut hits), 0);
+        assert_eq!(hits[0], ffi::QueryHit::default());
+        assert_eq!(hits[1], ffi::QueryHit::default());
+        assert_eq!(hits[2], stale);
+
+        let casts = [ffi::ShapeCastQuery {
+            shape: ffi::BodyShapeType::Circle,
+            position: origin,
+            angle: 0.0,
+            half_extents: origin,
+            radius: 0.5,
+            translation: reach,
+            mask_bits: 0xFFFF,
+        }];
+        let mut hits = [stale; 1];
+        assert_eq!(game.shape_cast_bodies(&casts, &mut hits), 0);
+        assert_eq!(hits[0].body, 0);
+
+        let boxes = [ffi::AabbQuery::new(origin, reach)];
+        let mut ids = [0_u64; 4];
+        let mut ranges = [ffi::QueryRange {
+            offset: 1,
+            count: 1,
+            found: 1,
+        }];
+        assert_eq!(game.query_aabb_bodies(&boxes, &mut ids, &mut ranges), 0);
+        assert_eq!(ranges[0], ffi::QueryRange::default());
+    }
+
+    #[test]
+    fn text_command_text_view_borrows_without_copy() {
+        let command = ffi::TextCommand {
+            text: "スコア: 42".to_string(),
+            position: ffi::Vec2 { x: 0.0, y: 0.0 },
+            font_size: 24.0,
+            color: ffi::Vec4 {
+                x: 1.0,
+                y: 1.0,
+                z: 1.0,
+                w: 1.0,
+            },
+        };
+        let view = crate::get_text_command_text_view(&command);
+        assert_eq!(view.ptr, command.text.as_ptr() as *const std::os::raw::c_char);
+        assert_eq!(view.len, command.text.len());
+
+        let null_view = crate::get_text_command_text_view(std::ptr::null());
+        assert_eq!(null_view, crate::MiyabiStringView::EMPTY);
+    }
+
+    #[test]
+    fn physics_snapshot_hex_round_trips() {
+        let bytes = [0x00_u8, 0x4d, 0x50, 0xff, 0x0a];
+        let encoded = crate::encode_hex(&bytes);
+        assert_eq!(encoded, "004d50ff0a");
+        assert_eq!(crate::decode_hex(&encoded).as_deref(), Some(&bytes[..]));
+        assert_eq!(crate::decode_hex("4D"), Some(vec![0x4d]));
+        assert_eq!(crate::decode_hex("abc"), None);
+        assert_eq!(crate::decode_hex("zz"), None);
+    }
+
     #[test]
     fn ffi_error_is_standardized() {
         assert_eq!(
@@ -4113,6 +4769,38 @@ pub extern "C" fn destroy_game(game: *mut Game) {
     }
 }
 
+// Key of the hex-encoded PhysicsManager snapshot in serialize_game output.
+const PHYSICS_SNAPSHOT_KEY: &str = "physics_snapshot";
+
+fn encode_hex(bytes: &[u8]) -> String {
+    const DIGITS: &[u8; 16] = b"0123456789abcdef";
+    let mut out = String::with_capacity(bytes.len() * 2);
+    for byte in bytes {
+        out.push(DIGITS[(byte >> 4) as usize] as char);
+        out.push(DIGITS[(byte & 0x0f) as usize] as char);
+    }
+    out
+}
+
+fn decode_hex(text: &str) -> Option<Vec<u8>> {
+    fn nibble(digit: u8) -> Option<u8> {
+        match digit {
+            b'0'..=b'9' => Some(digit - b'0'),
+            b'a'..=b'f' => Some(digit - b'a' + 10),
+            b'A'..=b'F' => Some(digit - b'A' + 10),
+            _ => None,
+        }
+    }
+    let digits = text.as_bytes();
+    if digits.len() % 2 != 0 {
+        return None;
+    }
+    digits
+        .chunks_exact(2)
+        .map(|pair| Some((nibble(pair[0])? << 4) | nibble(pair[1])?))
+        .collect()
+}
+
 #[no_mangle]
 pub extern "C" fn serialize_game(game: *const Game) -> *mut c_char {
     if game.is_null() {
@@ -4120,7 +4808,28 @@ pub extern "C" fn serialize_game(game: *const Game) -> *mut c_char {
         return ptr::null_mut();
     }
     let game = unsafe { &*game };
-    let serialized = match serde_json::to_string(game) {
+    let mut value = match serde_json::to_value(game) {
+        Ok(value) => value,
+        Err(err) => {
+            eprintln!(
+                "{}",
+                ffi_error("serialize_game", &format!("serialization failed: {err}"))
+            );
+            return ptr::null_mut();
+        }
+    };
+    // Embed the physics world so deserialize_game can restore it; the body
+    // ids stored in `world` resolve to the same bodies afterwards.
+    let physics_snapshot = runtime_bridge::save_physics_snapshot();
+    if !physics_snapshot.is_empty() {
+        if let Some(object) = value.as_object_mut() {
+            object.insert(
+                PHYSICS_SNAPSHOT_KEY.to_string(),
+                serde_json::Value::String(encode_hex(physics_snapshot)),
+            );
+        }
+    }
+    let serialized = match serde_json::to_string(&value) {
         Ok(serialized) => serialized,
         Err(err) => {
             eprintln!(
@@ -4162,7 +4871,20 @@ pub extern "C" fn deserialize_game(json: *const c_char) -> *mut Game {
             return ptr::null_mut();
         }
     };
-    let mut game: Game = match serde_json::from_str(r_str) {
+    let mut value: serde_json::Value = match serde_json::from_str(r_str) {
+        Ok(value) => value,
+        Err(err) => {
+            eprintln!(
+                "{}",
+                ffi_error("deserialize_game", &format!("JSON parse failed: {err}"))
+            );
+            return ptr::null_mut();
+        }
+    };
+    let physics_snapshot = value
+        .as_object_mut()
+        .and_then(|object| object.remove(PHYSICS_SNAPSHOT_KEY));
+    let mut game: Game = match serde_json::from_value(value) {
         Ok(value) => value,
         Err(err) => {
             eprintln!(
@@ -4185,6 +4907,22 @@ pub extern "C" fn deserialize_game(json: *const c_char) -> *mut Game {
     // Re-initialize non-serializable fields
     game.asset_server = AssetServer::new();
     // ... etc. for other non-serde fields
+    if let Some(snapshot) = physics_snapshot {
+        match snapshot.as_str().and_then(decode_hex) {
+            Some(bytes) => {
+                if !runtime_bridge::restore_physics_snapshot(&bytes) {
+                    eprintln!(
+                        "{}",
+                        ffi_error("deserialize_game", "physics snapshot restore failed")
+                    );
+                }
+            }
+            None => eprintln!(
+                "{}",
+                ffi_error("deserialize_game", "physics snapshot is not a hex string")
+            ),
+        }
+    }
     Box::into_raw(Box::new(game))
 }
 
@@ -4304,6 +5042,20 @@ pub extern "C" fn get_asset_command_path_cstring(command: *const ffi::AssetComma
     }
 }
 
+/// Borrows `command.path`; valid as long as the slice from `get_asset_commands`.
+#[no_mangle]
+pub extern "C" fn get_asset_command_path_view(command: *const ffi::AssetCommand) -> MiyabiStringView {
+    if command.is_null() {
+        eprintln!(
+            "{}",
+            ffi_null_pointer_error("get_asset_command_path_view", "command")
+        );
+        return MiyabiStringView::EMPTY;
+    }
+    let command = unsafe { &*command };
+    MiyabiStringView::borrow(command.path.as_str())
+}
+
 #[no_mangle]
 pub extern "C" fn get_text_commands(game: *mut Game) -> TextCommandSlice {
     if game.is_null() {
@@ -4345,6 +5097,21 @@ pub extern "C" fn get_text_command_text_cstring(command: *const ffi::TextCommand
     }
 }
 
+/// Borrows `command.text`; valid as long as the slice from `get_text_commands`,
+/// i.e. until the next `update_game`. No allocation, nothing to free.
+#[no_mangle]
+pub extern "C" fn get_text_command_text_view(command: *const ffi::TextCommand) -> MiyabiStringView {
+    if command.is_null() {
+        eprintln!(
+            "{}",
+            ffi_null_pointer_error("get_text_command_text_view", "command")
+        );
+        return MiyabiStringView::EMPTY;
+    }
+    let command = unsafe { &*command };
+    MiyabiStringView::borrow(command.text.as_str())
+}
+
 #[no_mangle]
 pub extern "C" fn free_cstring(s: *mut c_char) {
     if !s.is_null() {
@@ -19,6 +19,8 @@ fn make_test_game() -> Game {
         asset_commands: Vec::new(),
         text_commands: Vec::new(),
         collision_events: Vec::new(),
+        physics_rows: HashMap::new(),
+        physics_rows_version: None,
         hp: 3,
         survival_time_sec: 0.0,
         avoid_count: 0,
@@ -79,7 +79,7 @@ rm -rf "$BUILD_DIR" "$PACKAGE_DIR"
 mkdir -p "$PACKAGE_DIR/bin" "$PACKAGE_DIR/docs"
 
 echo "[package] configure release build"
-cmake -S "$ROOT_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DMIYABI_PERFORMANCE_TEST=OFF
+cmake -S "$ROOT_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DMIYABI_PERFORMANCE_TEST=OFF -DMIYABI_ASSET_HOT_RELOAD=OFF
 
 echo "[package] build"
 cmake --build "$BUILD_DIR" -j4
@@ -125,10 +125,9 @@ echo "[package] create checksum"
     assets/test_sound.wav \
     shaders/text.vert \
     shaders/text.frag \
-    shaders/textured.vert \
-    shaders/textured.frag \
-    shaders/lit_textured.vert \
-    shaders/lit_textured.frag > SHA256SUMS.txt
+    shaders/text_sdf.frag \
+    shaders/standard.vert \
+    shaders/standard.frag > SHA256SUMS.txt
 )
 
 echo "[package] archive"
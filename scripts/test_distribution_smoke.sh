@@ -32,10 +32,9 @@ for path in \
   assets/test_sound.wav \
   shaders/text.vert \
   shaders/text.frag \
-  shaders/textured.vert \
-  shaders/textured.frag \
-  shaders/lit_textured.vert \
-  shaders/lit_textured.frag \
+  shaders/text_sdf.frag \
+  shaders/standard.vert \
+  shaders/standard.frag \
   run_miyabi.sh \
   SHA256SUMS.txt \
   docs/README.txt
@@ -11,8 +11,8 @@ REPO_ROOT = pathlib.Path(__file__).resolve().parents[1]
 DEFAULT_OBJ_PATHS = ["assets/meshes/arena_cube.obj"]
 DEFAULT_TEXTURE_PATHS = ["assets/player.png", "assets/test.png"]
 DEFAULT_SHADER_PATHS = [
-    "core/src/shaders/lit_textured.vert",
-    "core/src/shaders/lit_textured.frag",
+    "core/src/shaders/standard.vert",
+    "core/src/shaders/standard.frag",
 ]
 
 